@@ -1,11 +1,49 @@
 #pragma once
 
+#include "apollo/chassis/asteriskDrive.hpp"
+#include "apollo/chassis/basicChassis.hpp"
+#include "apollo/chassis/characterization.hpp"
 #include "apollo/chassis/chassis.hpp"
+#include "apollo/chassis/controlLoop.hpp"
+#include "apollo/chassis/currentBudget.hpp"
+#include "apollo/chassis/driveCurve.hpp"
+#include "apollo/chassis/exitConditions.hpp"
+#include "apollo/chassis/gpsCorrection.hpp"
+#include "apollo/chassis/hDrive.hpp"
+#include "apollo/chassis/headingFilter.hpp"
+#include "apollo/chassis/holonomicDrive.hpp"
+#include "apollo/chassis/holonomicKinematics.hpp"
+#include "apollo/chassis/mecanum.hpp"
+#include "apollo/chassis/motion.hpp"
+#include "apollo/chassis/motionCommands.hpp"
+#include "apollo/chassis/motionRunner.hpp"
+#include "apollo/chassis/motions.hpp"
+#include "apollo/chassis/motorGroup.hpp"
+#include "apollo/chassis/odometry.hpp"
+#include "apollo/chassis/pose.hpp"
+#include "apollo/chassis/poseHistory.hpp"
+#include "apollo/chassis/sensorFrame.hpp"
+#include "apollo/chassis/slipDetector.hpp"
 #include "apollo/chassis/tankDrive.hpp"
+#include "apollo/chassis/trackers.hpp"
+#include "apollo/chassis/xDrive.hpp"
 
+#include "apollo/util/clock.hpp"
+#include "apollo/util/tripleBuffer.hpp"
 #include "apollo/util/util.hpp"
 #include "apollo/util/math.hpp"
 
+#include "apollo/control/feedforward.hpp"
+#include "apollo/control/motionProfile.hpp"
+#include "apollo/control/pidController.hpp"
+#include "apollo/control/profileCache.hpp"
+#include "apollo/control/purePursuit.hpp"
+#include "apollo/control/ramsete.hpp"
+
+#include "apollo/trajectory/spline.hpp"
+#include "apollo/trajectory/trajectory.hpp"
+#include "apollo/trajectory/trajectoryFile.hpp"
+
 #include "apollo/units/QAcceleration.hpp"
 #include "apollo/units/QAngle.hpp"
 #include "apollo/units/QAngularAcceleration.hpp"
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <vector>
+
+#include "apollo/chassis/holonomicDrive.hpp"
+
+namespace apollo {
+// Six wheels: X-drive omni wheels on the diagonals and a forward facing
+// omni wheel in the middle of each side. Motions drive the middle wheels
+// as tank sides and the corners follow through the kinematics.
+class AsteriskDrive : public HolonomicDrive<AsteriskKinematics> {
+ public:
+  // cornerRadius is the distance from the tracking center to each corner
+  // wheel, middleRadius to each middle wheel.
+  AsteriskDrive(std::vector<int> frontLeftMotorPorts,
+                std::vector<int> frontRightMotorPorts,
+                std::vector<int> backLeftMotorPorts,
+                std::vector<int> backRightMotorPorts,
+                std::vector<int> middleLeftMotorPorts,
+                std::vector<int> middleRightMotorPorts,
+                int inertialSensorPort, double cartridgeRPM,
+                double gearRatio, double wheelDiameter, QLength cornerRadius,
+                QLength middleRadius);
+  void setDimensions(QLength cornerRadius, QLength middleRadius);
+};
+}  // namespace apollo
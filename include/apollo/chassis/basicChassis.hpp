@@ -0,0 +1,393 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "apollo/chassis/driveCurve.hpp"
+#include "apollo/chassis/holonomicKinematics.hpp"
+#include "apollo/chassis/motionCommands.hpp"
+#include "apollo/chassis/motorGroup.hpp"
+#include "apollo/chassis/odometry.hpp"
+#include "apollo/chassis/pose.hpp"
+#include "apollo/chassis/sensorFrame.hpp"
+#include "apollo/chassis/trackers.hpp"
+#include "pros/imu.hpp"
+#include "pros/misc.h"
+#include "pros/motors.h"
+#include "pros/rtos.hpp"
+
+namespace apollo {
+// A drive put together from a kinematics and a trackers policy at compile
+// time, so a control tick is a single call with the wheel loops unrolled
+// and the kinematics and tracker math inlined. Nothing in it is virtual;
+// HolonomicDrive adapts it to Chassis.
+//
+// Kinematics (see FourWheelKinematics) lists the drive wheels, one motor
+// group each, and maps them to and from a HolonomicSpeeds. Motions drive it
+// like a tank whose sides are getSideRadius from the tracking center.
+// Trackers (see MotorTrackers) feed the odometry, with the IMU heading.
+//
+// Motion commands, gains and exit conditions go through the same
+// MotionCommands as Tank's, and driver curves work as on Tank. Tank's
+// heading filter, GPS correction, current budget and traction control are
+// not carried over: the IMU heading goes to the odometry unfiltered and the
+// motors run without managed current limits.
+// There is no characterize(); run a CharacterizationSequence through
+// startMotion and pass its fit to setFeedforward.
+template <typename Kinematics, typename Trackers = MotorTrackers>
+class BasicChassis {
+ public:
+  static constexpr std::size_t wheelCount = Kinematics::wheelCount;
+  using WheelArray = std::array<QSpeed, wheelCount>;
+
+  BasicChassis(const std::array<std::vector<int>, wheelCount>& motorPorts,
+               int inertialSensorPort, double cartridgeRPM, double gearRatio,
+               double wheelDiameter, Kinematics kinematics,
+               Trackers trackers = Trackers())
+      : inertialSensor(inertialSensorPort),
+        kinematics(kinematics),
+        requestedKinematics(kinematics),
+        trackers(std::move(trackers)),
+        drivetrainCartridgeRPMS(cartridgeRPM),
+        drivetrainGearRatio(gearRatio),
+        drivetrainWheelCircumference(wheelDiameter * M_PI) {
+    for (std::size_t i = 0; i < wheelCount; i++) {
+      driveMotors[i] = MotorGroup(motorPorts[i]);
+      driveMotors[i].setEncoderUnits(pros::E_MOTOR_ENCODER_DEGREES);
+    }
+    odometry.setOffsets(this->trackers.getOffsets());
+    maxVelocity = drivetrainCartridgeRPMS * drivetrainGearRatio;
+  }
+
+  // Called once per tick from the control task.
+  void update() {
+    if (sensorResetRequested) {
+      applySensorReset();
+    }
+    if (kinematicsChangeRequested) {
+      applyKinematicsChange();
+    }
+    sampleSensors();
+    updateOdometry();
+    Pose pose = odometry.getPose();
+    poseBuffer.publish(pose);
+    runMotion(pose);
+  }
+  // Taring devices under a running odometry would look like a jump in
+  // position, so the reset is applied from the control task.
+  void resetSensors() { sensorResetRequested = true; }
+
+  // Wheel voltages for a robot-relative velocity, desaturated so that no
+  // wheel is asked for more than the top wheel speed. All wheels scale
+  // together, which keeps the direction of motion.
+  void moveVelocity(const HolonomicSpeeds& speeds) {
+    moveWheels(requestedKinematics, speeds);
+  }
+  // Driver control from the master controller, called from opcontrol.
+  // setTank drives each side from its axis, setArcade takes forward on
+  // leftAxis and turn on rightAxis. strafeAxis may be null and is shaped
+  // by the drive curve.
+  void setTank(pros::controller_analog_e_t leftAxis,
+               pros::controller_analog_e_t rightAxis,
+               pros::controller_analog_e_t* strafeAxis) {
+    double left = (*driveCurve)(readAxis(leftAxis));
+    double right = (*driveCurve)(readAxis(rightAxis));
+    double strafe = strafeAxis ? (*driveCurve)(readAxis(*strafeAxis)) : 0;
+    moveVelocity(readDriverAxes((left + right) / 2, strafe,
+                                (left - right) / 2));
+  }
+  void setArcade(pros::controller_analog_e_t leftAxis,
+                 pros::controller_analog_e_t rightAxis,
+                 pros::controller_analog_e_t* strafeAxis) {
+    moveVelocity(readDriverAxes(
+        (*driveCurve)(readAxis(leftAxis)),
+        strafeAxis ? (*driveCurve)(readAxis(*strafeAxis)) : 0,
+        (*turnCurve)(readAxis(rightAxis))));
+  }
+  // Curves are kept by pointer, see Tank::setDriveCurve.
+  void setDriveCurve(const DriveCurve& curve) { driveCurve = &curve; }
+  void setTurnCurve(const DriveCurve& curve) { turnCurve = &curve; }
+  // With field-centric control on, driver forward and strafe keep the
+  // directions they had when it was turned on, whichever way the robot
+  // faces.
+  void setFieldCentric(bool enabled) {
+    fieldHeading = getPose().theta.convert(radian);
+    fieldCentric = enabled;
+  }
+
+  MotionHandle setDrivePID(QLength targetDistance, QSpeed targetVelocity) {
+    return motionCommands.drive(targetDistance, targetVelocity, getSides());
+  }
+  MotionHandle setTurnPID(QAngle targetAngle, QAngularSpeed targetVelocity) {
+    return motionCommands.turn(targetAngle, targetVelocity, getSides());
+  }
+  MotionHandle setSwingPID(direction targetDirection, QAngle targetAngle,
+                           QAngularSpeed targetVelocity) {
+    return motionCommands.swing(targetDirection, targetAngle, targetVelocity,
+                                getSides());
+  }
+  MotionHandle followPath(std::vector<Waypoint> path, QLength lookahead,
+                          QSpeed targetVelocity = QSpeed()) {
+    return motionCommands.followPath(std::move(path), lookahead,
+                                     targetVelocity, getSides());
+  }
+  MotionHandle followTrajectory(
+      std::shared_ptr<const TrajectorySource> trajectory) {
+    return motionCommands.followTrajectory(std::move(trajectory), getSides());
+  }
+  // Top side speed and the distance between the virtual tank sides.
+  TrajectoryConstraints getTrajectoryConstraints(
+      QAcceleration maxAcceleration) const {
+    return {getTopSideSpeed(), maxAcceleration, getTrackWidth()};
+  }
+  void setRamseteGains(double b, double zeta) {
+    motionCommands.setRamseteGains(b, zeta);
+  }
+  MotionHandle startMotion(std::shared_ptr<Motion> motion) {
+    return motionCommands.start(std::move(motion));
+  }
+  void cancelMotion() { motionCommands.cancel(); }
+  void beginChain(QSpeed handoffVelocity) {
+    motionCommands.beginChain(handoffVelocity);
+  }
+  void endChain() { motionCommands.endChain(); }
+
+  void setBrakeMode(pros::motor_brake_mode_e_t mode) {
+    for (MotorGroup& motors : driveMotors) {
+      motors.setBrakeMode(mode);
+    }
+  }
+  void setGearing(double gearing) { drivetrainGearRatio = gearing; }
+  void setMaxVelocity(double velocity) { maxVelocity = velocity; }
+  void setMaxVoltage(double voltage) { maxVoltage = voltage; }
+  pros::motor_brake_mode_e_t getBrakeMode() const {
+    return driveMotors[0].getBrakeMode();
+  }
+  double getGearing() const { return drivetrainGearRatio; }
+  // Odometry always reads the drive motors in degrees.
+  double getEncoderUnits() const { return 360; }
+  double getMaxVelocity() const { return maxVelocity; }
+  double getMaxVoltage() const { return maxVoltage; }
+  void setDriveGains(PIDGains gains) { motionCommands.setDriveGains(gains); }
+  void setHeadingGains(PIDGains gains) {
+    motionCommands.setHeadingGains(gains);
+  }
+  void setTurnGains(PIDGains gains) { motionCommands.setTurnGains(gains); }
+  void setSwingGains(PIDGains gains) { motionCommands.setSwingGains(gains); }
+  void setDriveConstraints(QAcceleration acceleration, QJerk jerk = QJerk()) {
+    motionCommands.setDriveConstraints(acceleration, jerk);
+  }
+  // Side model in side speed. Until one is set, voltage is scaled linearly
+  // from the top side speed.
+  void setFeedforward(FeedforwardGains gains) {
+    motionCommands.setFeedforward(gains);
+  }
+  Feedforward getFeedforward() const {
+    return motionCommands.getFeedforward(getSides());
+  }
+  void setDriveExitConditions(const ExitConditions& conditions) {
+    motionCommands.setDriveExitConditions(conditions);
+  }
+  void setTurnExitConditions(const ExitConditions& conditions) {
+    motionCommands.setTurnExitConditions(conditions);
+  }
+  // Like a sensor reset, the change is handed to the control task, which
+  // picks it up at the start of its next tick. Calls from this side see it
+  // straight away.
+  void setKinematics(const Kinematics& kinematics) {
+    kinematicsMutex.take(TIMEOUT_MAX);
+    requestedKinematics = kinematics;
+    kinematicsChangeRequested = true;
+    kinematicsMutex.give();
+  }
+  const Kinematics& getKinematics() const { return requestedKinematics; }
+  const SensorFrame& getSensorFrame() const { return sensorFrame; }
+  Pose getPose() const { return poseBuffer.read(); }
+  void setPose(const Pose& pose) { poseResetBuffer.publish(pose); }
+
+ protected:
+  void applySensorReset() {
+    for (MotorGroup& motors : driveMotors) {
+      motors.tarePosition();
+    }
+    trackers.reset();
+    inertialSensor.tare();
+    odometry.reset();
+    sensorResetRequested = false;
+  }
+  void applyKinematicsChange() {
+    kinematicsMutex.take(TIMEOUT_MAX);
+    kinematics = requestedKinematics;
+    kinematicsChangeRequested = false;
+    kinematicsMutex.give();
+  }
+
+  // Each wheel's motors go into its side's sensor frame slots.
+  void sampleSensors() {
+    sensorFrame.timestamp = pros::micros() * microsecond;
+    sensorFrame.leftMotorCount = 0;
+    sensorFrame.rightMotorCount = 0;
+    for (std::size_t wheel = 0; wheel < wheelCount; wheel++) {
+      bool left = Kinematics::leftWheels[wheel];
+      std::array<MotorSample, SensorFrame::maxSideMotors>& samples =
+          left ? sensorFrame.leftMotors : sensorFrame.rightMotors;
+      std::size_t& count =
+          left ? sensorFrame.leftMotorCount : sensorFrame.rightMotorCount;
+      MotorGroup& motors = driveMotors[wheel];
+      QAngle position;
+      QAngularSpeed velocity;
+      for (std::size_t i = 0; i < motors.size(); i++) {
+        MotorSample sample;
+        sample.position = motors[i].get_position() * degree;
+        sample.velocity = motors[i].get_actual_velocity() * rpm;
+        sample.current = motors[i].get_current_draw();
+        position += sample.position;
+        velocity += sample.velocity;
+        if (count < SensorFrame::maxSideMotors) {
+          samples[count++] = sample;
+        }
+      }
+      double motorCount = std::max<std::size_t>(motors.size(), 1);
+      // Distances are kept as the speed that covers them in one second so
+      // they go through the same, linear, kinematics as velocities.
+      wheelDistances[wheel] =
+          (position.convert(degree) / motorCount / 360 *
+           drivetrainGearRatio * drivetrainWheelCircumference) *
+          inch / second;
+      wheelVelocities[wheel] = wheelSpeed(velocity / motorCount);
+    }
+    trackers.sample();
+    sensorFrame.heading = inertialSensor.get_heading() * degree;
+    sensorFrame.rotation = inertialSensor.get_rotation() * degree;
+    sensorFrame.headingRate =
+        inertialSensor.get_gyro_rate().z * degree / second;
+  }
+
+  void updateOdometry() {
+    // Pose resets are handed over through a buffer so they are applied
+    // from the control task instead of racing the integration.
+    if (poseResetBuffer.getVersion() != poseResetVersion) {
+      poseResetVersion = poseResetBuffer.getVersion();
+      odometry.setPose(poseResetBuffer.read());
+    }
+    wheelTravel = kinematics.forward(Kinematics::fromArray(wheelDistances));
+    TrackerReadings readings = trackers.measure(wheelTravel);
+    // The IMU reports clockwise positive angles.
+    odometry.update(readings.left, readings.right, readings.center,
+                    sensorFrame.rotation * -1, sensorFrame.timestamp);
+  }
+
+  // Side outputs are turned back into a chassis velocity for the wheels.
+  void runMotion(const Pose& pose) {
+    QLength sideRadius = kinematics.getSideRadius();
+    HolonomicSpeeds velocity =
+        kinematics.forward(Kinematics::fromArray(wheelVelocities));
+    QSpeed travelTurn =
+        (wheelTravel.angular.convert(radps) * sideRadius) / second;
+    QSpeed velocityTurn =
+        (velocity.angular.convert(radps) * sideRadius) / second;
+    DriveOutput output;
+    if (motionCommands.run({sensorFrame, pose,
+                            (wheelTravel.forward - travelTurn) * second,
+                            (wheelTravel.forward + travelTurn) * second,
+                            velocity.forward - velocityTurn,
+                            velocity.forward + velocityTurn,
+                            sensorFrame.timestamp},
+                           output)) {
+      QSpeed topSpeed = getTopSpeed() * kinematics.getSideScale();
+      QSpeed forward =
+          topSpeed * ((output.left + output.right) / 2 / maxVoltage);
+      QSpeed turn = topSpeed * ((output.right - output.left) / 2 / maxVoltage);
+      moveWheels(kinematics,
+                 {forward, QSpeed(),
+                  (turn.convert(mps) / sideRadius.convert(meter)) * radps});
+    }
+  }
+
+  void moveWheels(const Kinematics& wheelKinematics,
+                  const HolonomicSpeeds& speeds) {
+    QSpeed topSpeed = getTopSpeed();
+    WheelArray wheels = desaturate(
+        Kinematics::toArray(wheelKinematics.inverse(speeds)), topSpeed);
+    double voltsPerSpeed =
+        topSpeed > 0 * mps ? maxVoltage / topSpeed.convert(mps) : 0;
+    for (std::size_t i = 0; i < wheelCount; i++) {
+      driveMotors[i].moveVoltage(wheels[i].convert(mps) * voltsPerSpeed);
+    }
+  }
+
+  static std::int32_t readAxis(pros::controller_analog_e_t axis) {
+    return pros::c::controller_get_analog(pros::E_CONTROLLER_MASTER, axis);
+  }
+  // Axes are fractions of full stick. A full stick asks for the top speed
+  // of the wheels or sides it drives.
+  HolonomicSpeeds readDriverAxes(double forward, double strafe,
+                                 double turn) const {
+    QSpeed sideSpeed = getTopSideSpeed();
+    HolonomicSpeeds speeds{
+        sideSpeed * forward,
+        getTopSpeed() * (strafe * requestedKinematics.getStrafeScale()),
+        (sideSpeed.convert(mps) * -turn /
+         requestedKinematics.getSideRadius().convert(meter)) *
+            radps};
+    if (fieldCentric) {
+      speeds = toRobotFrame(
+          speeds, getPose().theta - fieldHeading.load() * radian);
+    }
+    return speeds;
+  }
+
+  QSpeed wheelSpeed(QAngularSpeed motorVelocity) const {
+    return (motorVelocity.convert(rpm) * drivetrainGearRatio *
+            drivetrainWheelCircumference / 60) *
+           inch / second;
+  }
+  QSpeed getTopSpeed() const {
+    return (maxVelocity * drivetrainWheelCircumference / 60) * inch / second;
+  }
+  QSpeed getTopSideSpeed() const {
+    return getTopSpeed() * requestedKinematics.getSideScale();
+  }
+  QLength getTrackWidth() const {
+    return requestedKinematics.getSideRadius() * 2;
+  }
+  SideModel getSides() const {
+    return {getTopSideSpeed(), getTrackWidth(), maxVoltage};
+  }
+
+  std::array<MotorGroup, wheelCount> driveMotors;
+  pros::Imu inertialSensor;
+  // kinematics is the control task's copy, requestedKinematics the one
+  // set and read from the user's tasks.
+  Kinematics kinematics;
+  Kinematics requestedKinematics;
+  pros::Mutex kinematicsMutex;
+  std::atomic<bool> kinematicsChangeRequested{false};
+  Trackers trackers;
+  double drivetrainCartridgeRPMS = 0;
+  double drivetrainGearRatio = 0;
+  double drivetrainWheelCircumference = 0;
+  SensorFrame sensorFrame;
+  WheelArray wheelDistances;
+  WheelArray wheelVelocities;
+  HolonomicSpeeds wheelTravel;
+  Odometry odometry;
+  PoseBuffer poseBuffer;
+  PoseBuffer poseResetBuffer;
+  std::uint32_t poseResetVersion = 0;
+  std::atomic<bool> sensorResetRequested{false};
+  std::atomic<bool> fieldCentric{false};
+  std::atomic<double> fieldHeading{0};
+  double maxVelocity = 0;
+  double maxVoltage = 12000;
+  const DriveCurve* driveCurve = &linearDriveCurve;
+  const DriveCurve* turnCurve = &linearDriveCurve;
+  MotionCommands motionCommands;
+};
+}  // namespace apollo
@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "apollo/chassis/motion.hpp"
+#include "apollo/control/feedforward.hpp"
+
+namespace apollo {
+// Drives both sides open loop and records the voltage and the distance
+// travelled every tick for fitFeedforward. A quasistatic test ramps the
+// voltage by voltage millivolts per second, slowly enough that kA drops
+// out; a step test applies voltage at once to excite kA. The run stops
+// after duration or maxDistance, whichever comes first. Negative voltages
+// drive backwards.
+class CharacterizationMotion : public Motion {
+ public:
+  enum testType { test_quasistatic, test_step };
+  CharacterizationMotion(testType type, double voltage, QTime duration,
+                         QLength maxDistance);
+  void start(const MotionContext& context) override;
+  DriveOutput step(const MotionContext& context) override;
+  // Only read once the motion has settled.
+  const std::vector<CharacterizationSample>& getSamples() const;
+
+ private:
+  testType type;
+  double voltage;
+  QLength maxDistance;
+  QLength startLeft;
+  QLength startRight;
+  std::vector<CharacterizationSample> samples;
+};
+
+// rampRate is the quasistatic ramp in millivolts per second, duration and
+// maxDistance bound every run, and the robot has to be still for restTime
+// before the next run starts.
+struct CharacterizationSettings {
+  double rampRate = 250;
+  double stepVoltage = 6000;
+  QTime duration = 6 * second;
+  QLength maxDistance = 1.5 * meter;
+  QTime restTime = 500 * millisecond;
+};
+
+// Runs the quasistatic and step tests, each forwards then backwards so the
+// robot ends up near where it started, as a single motion. Once it has
+// settled the runs can be logged and fit.
+class CharacterizationSequence : public Motion {
+ public:
+  enum runType {
+    quasistatic_forward,
+    quasistatic_backward,
+    step_forward,
+    step_backward
+  };
+  static constexpr std::size_t runCount = 4;
+  explicit CharacterizationSequence(
+      const CharacterizationSettings& settings = CharacterizationSettings());
+  void start(const MotionContext& context) override;
+  DriveOutput step(const MotionContext& context) override;
+  // Only read once the motion has settled.
+  const std::vector<CharacterizationSample>& getSamples(runType index) const;
+  // Writes every run to <prefix>_<run>.csv, e.g.
+  // /usd/characterization_step_forward.csv.
+  bool writeLogs(const char* prefix) const;
+  bool fit(FeedforwardGains& gains) const;
+
+ private:
+  std::array<std::unique_ptr<CharacterizationMotion>, runCount> runs;
+  QTime restTime;
+  std::size_t current = 0;
+  bool resting = true;
+  QTime stillSince;
+};
+}  // namespace apollo
@@ -1,5 +1,10 @@
 #pragma once
+#include "apollo/chassis/motion.hpp"
+#include "apollo/units/QAngle.hpp"
+#include "apollo/units/QAngularSpeed.hpp"
 #include "apollo/units/QDirection.hpp"
+#include "apollo/units/QLength.hpp"
+#include "apollo/units/QSpeed.hpp"
 #include "pros/misc.h"
 #include "pros/motors.h"
 using namespace pros;
@@ -18,23 +23,30 @@ class Chassis {
     tracker_encoder_wheel = 2,
     tracker_rotation_wheel = 3
   };
+  virtual ~Chassis() = default;
+  // Called once per tick by apollo::ControlLoop.
+  virtual void update() {}
   virtual void resetSensors() = 0;
   virtual void setBrakeMode(motor_brake_mode_e_t mode) = 0;
   virtual void setGearing(double gearing) = 0;
   virtual void setEncoderUnits(double units) = 0;
   virtual void setMaxVelocity(double velocity) = 0;
   virtual void setMaxVoltage(double voltage) = 0;
-  virtual void setDrivePID(double targetDistance, double targetVelocity) = 0;
-  virtual void setTurnPID(double targetAngle, double targetVelocity) = 0;
-  virtual void setSwingPID(direction targetDirection, double targetAngle,
-                           double targetVelocity) = 0;
+  // Motion commands return immediately and run on the chassis task.
+  virtual MotionHandle setDrivePID(QLength targetDistance,
+                                   QSpeed targetVelocity) = 0;
+  virtual MotionHandle setTurnPID(QAngle targetAngle,
+                                  QAngularSpeed targetVelocity) = 0;
+  virtual MotionHandle setSwingPID(direction targetDirection,
+                                   QAngle targetAngle,
+                                   QAngularSpeed targetVelocity) = 0;
   virtual void setTank(controller_analog_e_t leftAxis,
                        controller_analog_e_t rightAxis,
                        controller_analog_e_t* strafeAxis) = 0;
   virtual void setArcade(controller_analog_e_t leftAxis,
                          controller_analog_e_t rightAxis,
                          controller_analog_e_t* strafeAxis) = 0;
-  virtual motor_gearset_e_t getBrakeMode() const = 0;
+  virtual motor_brake_mode_e_t getBrakeMode() const = 0;
   virtual double getGearing() const = 0;
   virtual double getEncoderUnits() const = 0;
   virtual double getMaxVelocity() const = 0;
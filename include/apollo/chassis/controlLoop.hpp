@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "apollo/chassis/chassis.hpp"
+#include "apollo/util/clock.hpp"
+#include "apollo/util/tripleBuffer.hpp"
+#include "pros/rtos.hpp"
+
+namespace apollo {
+class ControlLoop {
+ public:
+  enum loopPeriod { period_5ms = 5, period_10ms = 10, period_20ms = 20 };
+  // All times are in microseconds. Jitter is the distance between the
+  // measured and the nominal tick period.
+  struct Statistics {
+    std::uint32_t ticks = 0;
+    std::uint32_t overruns = 0;
+    std::uint64_t lastPeriod = 0;
+    std::uint64_t lastExecutionTime = 0;
+    std::uint64_t maxExecutionTime = 0;
+    std::uint64_t maxJitter = 0;
+    double meanJitter = 0;
+  };
+  ControlLoop(Chassis& chassis, loopPeriod period = period_10ms);
+  ControlLoop(Chassis& chassis, loopPeriod period, util::Clock& clock);
+  ~ControlLoop();
+  void start(std::uint32_t priority = TASK_PRIORITY_DEFAULT + 2);
+  void stop();
+  void step();
+  // Takes effect at the start of the next tick.
+  void resetStatistics();
+  bool isRunning() const;
+  std::uint32_t getPeriod() const;
+  // The statistics as of the end of the last tick. They are published once
+  // per tick, so a read from another task never mixes two ticks.
+  Statistics getStatistics() const;
+
+ protected:
+  Chassis& chassis;
+  util::Clock& clock;
+  std::uint32_t period;
+  std::uint32_t wakeTime = 0;
+  std::uint64_t lastTickStart = 0;
+  bool firstTick = true;
+  Statistics statistics;
+  util::TripleBuffer<Statistics> publishedStatistics;
+  std::atomic<bool> statisticsResetRequested{false};
+  std::atomic<bool> running{false};
+  std::atomic<bool> taskExited{true};
+  std::unique_ptr<pros::Task> task;
+};
+}  // namespace apollo
@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "apollo/chassis/motorGroup.hpp"
+#include "pros/rtos.hpp"
+
+namespace apollo {
+// Shares the brain's motor current between motor groups through their
+// current limits. Each update every group gets its minimum, then the rest
+// goes out in priority order, first up to what each group is using plus
+// some headroom and then up to each group's maximum. Groups with the same
+// priority, such as the two drive sides, split what is left evenly. A
+// group that needs more current than it has gets it from lower priorities
+// over the next ticks. Slipping groups are capped at their slip limit,
+// since more current would only spin the wheels.
+//
+// The work per update is bounded by maxGroups and the motors in them, with
+// no allocation, so it can run on the control task.
+class CurrentBudget {
+ public:
+  static constexpr std::size_t maxGroups = 8;
+  // Per motor limits in milliamps. Higher priorities are served first and
+  // groups with equal priority in the order they were added.
+  struct GroupLimits {
+    int priority = 0;
+    std::int32_t minimum = 500;
+    std::int32_t maximum = 2500;
+    std::int32_t slipLimit = 1500;
+  };
+  struct Parameters {
+    // Total for every motor in the budget.
+    std::int32_t totalLimit = 20000;
+    // How far above its present draw a motor's limit is kept.
+    std::int32_t headroom = 500;
+    // Limits are rounded down to this step so a limit isn't resent for
+    // every small change in draw, but never below the group's minimum.
+    std::int32_t step = 100;
+  };
+  CurrentBudget();
+  explicit CurrentBudget(Parameters parameters);
+  void setParameters(Parameters parameters);
+  // Groups are kept by reference. Returns the group's index, or maxGroups
+  // once the budget is full.
+  std::size_t addGroup(MotorGroup& motors, GroupLimits limits);
+  void setLimits(std::size_t group, GroupLimits limits);
+  void setSlipping(std::size_t group, bool slipping);
+  // Total draw of the group's motors in milliamps, for groups the caller
+  // has already sampled this tick. The next update uses it instead of
+  // reading the motors again; without it the motors are read.
+  void setCurrentDraw(std::size_t group, std::int32_t draw);
+  // Call once per tick. Skips the tick if a caller is changing groups.
+  void update();
+  // Per motor limit last given to the group.
+  std::int32_t getLimit(std::size_t group) const;
+  std::size_t size() const;
+
+ protected:
+  struct Group {
+    MotorGroup* motors = nullptr;
+    GroupLimits limits;
+    std::int32_t limit = 0;
+    bool slipping = false;
+    std::int32_t sampledDraw = 0;
+    bool drawSampled = false;
+  };
+  void sortByPriority();
+  std::int32_t share(std::size_t first, std::size_t last,
+                     const std::array<std::int32_t, maxGroups>& targets,
+                     std::int32_t remaining);
+  Parameters parameters;
+  std::array<Group, maxGroups> groups;
+  // Group indices, highest priority first.
+  std::array<std::size_t, maxGroups> order;
+  std::size_t count = 0;
+  pros::Mutex mutex;
+};
+}  // namespace apollo
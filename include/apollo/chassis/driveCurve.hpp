@@ -0,0 +1,94 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "apollo/util/math.hpp"
+
+namespace apollo {
+// Driver input shaping for one joystick axis. The deadband and curve are
+// evaluated for every raw value when the curve is built, so reading the
+// shaped value is a single table lookup. Build curves as constexpr or
+// static objects; drives keep a pointer to the curve they were given.
+class DriveCurve {
+ public:
+  static constexpr std::size_t tableSize = 256;
+  static constexpr int maxInput = 127;
+  enum curveType { curve_linear, curve_exponential, curve_cubic };
+
+  // curvature is the exponential curve's strength in joystick units, 0 is
+  // linear. cubicWeight blends between linear (0) and x^3 (1). Raw values
+  // within deadband of center read as zero and the rest of the travel is
+  // stretched to cover the full output range.
+  constexpr DriveCurve(curveType type = curve_linear, double shape = 0,
+                       int deadband = 0)
+      : table() {
+    for (std::size_t i = 0; i < tableSize; i++) {
+      // Indexing by the low byte maps raw values -128..127 onto the table.
+      int raw = static_cast<std::int8_t>(static_cast<std::uint8_t>(i));
+      table[i] = evaluate(type, shape, deadband, raw);
+    }
+  }
+  static constexpr DriveCurve linear(int deadband = 0) {
+    return DriveCurve(curve_linear, 0, deadband);
+  }
+  static constexpr DriveCurve exponential(double curvature,
+                                          int deadband = 0) {
+    return DriveCurve(curve_exponential, curvature, deadband);
+  }
+  static constexpr DriveCurve cubic(double cubicWeight, int deadband = 0) {
+    return DriveCurve(curve_cubic, cubicWeight, deadband);
+  }
+
+  // Shaped output for a raw controller_get_analog value, as a fraction of
+  // full stick from -1 to 1.
+  constexpr double operator()(std::int32_t raw) const {
+    return table[static_cast<std::uint8_t>(raw)];
+  }
+
+ protected:
+  static constexpr double evaluate(curveType type, double shape,
+                                   int deadband, int raw) {
+    int magnitude = raw < 0 ? -raw : raw;
+    if (magnitude <= deadband || deadband >= maxInput) {
+      return 0;
+    }
+    // Full stick is exactly full output, whatever rounding the curve does.
+    if (magnitude >= maxInput) {
+      return raw < 0 ? -1 : 1;
+    }
+    double x = math::clipValues(
+        static_cast<double>(magnitude - deadband) / (maxInput - deadband), 1,
+        0);
+    double y = x;
+    if (type == curve_exponential) {
+      // Flat near center and reaching full output at full stick.
+      double center = math::exponential(-shape / 10);
+      y = (center +
+           math::exponential((x - 1) * maxInput / 10) * (1 - center)) *
+          x;
+    } else if (type == curve_cubic) {
+      y = shape * x * x * x + (1 - shape) * x;
+    }
+    return raw < 0 ? -y : y;
+  }
+  std::array<double, tableSize> table;
+};
+
+inline constexpr DriveCurve linearDriveCurve;
+
+static_assert(linearDriveCurve(DriveCurve::maxInput) == 1 &&
+                  linearDriveCurve(-DriveCurve::maxInput) == -1 &&
+                  linearDriveCurve(0) == 0,
+              "the linear curve must be built at compile time");
+static_assert(DriveCurve::exponential(20, 10)(DriveCurve::maxInput) == 1 &&
+                  DriveCurve::exponential(20, 10)(-128) == -1 &&
+                  DriveCurve::exponential(20, 10)(-10) == 0 &&
+                  DriveCurve::exponential(20, 10)(11) > 0,
+              "exponential curves must reach +-1 and zero the deadband");
+static_assert(DriveCurve::cubic(0.5, 10)(DriveCurve::maxInput) == 1 &&
+                  DriveCurve::cubic(0.5, 10)(-128) == -1 &&
+                  DriveCurve::cubic(0.5, 10)(10) == 0 &&
+                  DriveCurve::cubic(0.5, 10)(-11) < 0,
+              "cubic curves must reach +-1 and zero the deadband");
+}  // namespace apollo
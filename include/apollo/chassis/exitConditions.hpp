@@ -0,0 +1,79 @@
+#pragma once
+#include "apollo/chassis/sensorFrame.hpp"
+#include "apollo/units/QAngularSpeed.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+enum exitReason {
+  exit_none,
+  exit_small_error,
+  exit_large_error,
+  exit_velocity,
+  exit_stall,
+  exit_timeout,
+  exit_completed,
+  exit_handoff,
+  exit_cancelled
+};
+
+// When a motion counts as done. Errors are in the motion's units (meters
+// or radians) and velocity is how fast that error changes, per second.
+// Each window has to hold for its time, and a zero time disables it.
+//  - small error: inside smallError, the normal finish
+//  - large error: inside largeError, for when close is good enough
+//  - velocity: the error stopped changing while inside largeError
+//  - stall: the drive motors draw at least stallCurrent (mA) while turning
+//    slower than stallVelocity, e.g. pushed against a wall
+// timeout is a hard limit on top of the motion's expected duration.
+struct ExitConditions {
+  double smallError = 0;
+  QTime smallErrorTime;
+  double largeError = 0;
+  QTime largeErrorTime;
+  double minVelocity = 0;
+  QTime velocityTime;
+  double stallCurrent = 0;
+  QAngularSpeed stallVelocity;
+  QTime stallTime;
+  QTime timeout;
+};
+
+constexpr ExitConditions defaultDriveExit{
+    0.0127, 100 * millisecond,  // half an inch
+    0.05,   500 * millisecond,  // two inches
+    0.01,   250 * millisecond,  // 1 cm/s
+    2000,   5 * rpm,  300 * millisecond,
+    4 * second};
+constexpr ExitConditions defaultTurnExit{
+    0.0175, 100 * millisecond,  // one degree
+    0.0524, 500 * millisecond,  // three degrees
+    0.02,   250 * millisecond,  // about 1 deg/s
+    2000,   5 * rpm,  300 * millisecond,
+    4 * second};
+
+// Runs the windows of one set of exit conditions over a motion.
+class ExitConditionMonitor {
+ public:
+  // expectedDuration extends the timeout for motions that are meant to
+  // take a known time, like a profile or trajectory.
+  void reset(QTime timestamp, QTime expectedDuration = QTime());
+  exitReason update(const ExitConditions& conditions, double error,
+                    const SensorFrame& frame, QTime timestamp);
+
+ protected:
+  struct Window {
+    bool inside = false;
+    QTime since;
+    bool update(bool condition, QTime timestamp, QTime duration);
+  };
+  QTime startTime;
+  QTime expectedDuration;
+  QTime lastTime;
+  double lastError = 0;
+  bool hasError = false;
+  Window smallWindow;
+  Window largeWindow;
+  Window velocityWindow;
+  Window stallWindow;
+};
+}  // namespace apollo
@@ -0,0 +1,64 @@
+#pragma once
+#include "apollo/chassis/pose.hpp"
+#include "apollo/chassis/poseHistory.hpp"
+#include "apollo/chassis/sensorFrame.hpp"
+#include "apollo/units/QLength.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+// Blends absolute GPS fixes into the odometry pose. Odometry is never
+// modified: the layer keeps a field offset that is added to it, and every
+// fix is compared against where odometry put the robot when the fix was
+// taken. The odometry pose has to be in the GPS field frame for this to
+// make sense, so set it from the GPS before enabling corrections.
+class GpsCorrection {
+ public:
+  struct Parameters {
+    QTime latency = 40 * millisecond;
+    // Identical readings closer together than this are one fix read twice.
+    // Keep it above the control period and below the sensor's fix period.
+    QTime repeatWindow = 15 * millisecond;
+    QLength initialError = 5 * centimeter;
+    QLength maxError = 5 * centimeter;
+    QLength minError = 5 * millimeter;
+    // Odometry drift, as the standard deviation in meters after one meter of
+    // travel. The variance grows linearly with distance.
+    double driftPerMeter = 0.02;
+    // Fixes further than this many standard deviations away are rejected.
+    double outlierGate = 3;
+    int maxConsecutiveOutliers = 10;
+  };
+  enum sampleResult {
+    sample_accepted = 0,
+    sample_rejected_error = 1,
+    sample_rejected_outlier = 2,
+    sample_rejected_no_history = 3,
+    sample_repeated = 4
+  };
+  GpsCorrection();
+  explicit GpsCorrection(Parameters parameters);
+  void setParameters(Parameters parameters);
+  // Call once per tick with the raw odometry pose.
+  void recordPose(const Pose& odometryPose);
+  // Can be called every tick. The sensor reports slower than the control
+  // loop runs, so the same fix is read more than once. A reading identical
+  // to the last new one within repeatWindow of it is that fix again and is
+  // not fused twice. Later, it is a new fix that happens to match, as on a
+  // robot standing still.
+  sampleResult addSample(const GpsSample& sample);
+  Pose apply(const Pose& odometryPose) const;
+  void reset();
+  QLength getOffsetX() const;
+  QLength getOffsetY() const;
+
+ protected:
+  Parameters parameters;
+  PoseHistory<64> history;
+  QLength offsetX;
+  QLength offsetY;
+  double variance = 0;
+  int consecutiveOutliers = 0;
+  GpsSample lastSample;
+  bool hasLastSample = false;
+};
+}  // namespace apollo
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+#include "apollo/chassis/holonomicKinematics.hpp"
+#include "apollo/chassis/tankDrive.hpp"
+
+namespace apollo {
+// A tank drive with a strafe wheel group across the middle. The strafe
+// wheels have their own gearing and wheel size, and their motor encoders
+// are the odometry's perpendicular tracker. Motions drive the sides and
+// hold the strafe wheels still. trackWidth sets the side tracking offsets,
+// which turning and the kinematics need from the start.
+class HDrive : public Tank {
+ public:
+  HDrive(std::vector<int> leftDriveMotorPorts,
+         std::vector<int> rightDriveMotorPorts,
+         std::vector<int> strafeMotorPorts, int inertialSensorPort,
+         double cartridgeRPM, double gearRatio, double wheelDiameter,
+         double strafeGearRatio, double strafeWheelDiameter,
+         QLength trackWidth);
+  void setBrakeMode(motor_brake_mode_e_t mode) override;
+  // Driver control as on Tank; strafeAxis may be null and is shaped by
+  // the drive curve.
+  void setTank(controller_analog_e_t leftAxis,
+               controller_analog_e_t rightAxis,
+               controller_analog_e_t* strafeAxis) override;
+  void setArcade(controller_analog_e_t leftAxis,
+                 controller_analog_e_t rightAxis,
+                 controller_analog_e_t* strafeAxis) override;
+  // Share of the top strafe wheel speed a full strafe stick asks for.
+  void setStrafeScale(double scale);
+  // Side and strafe voltages for a robot-relative velocity, desaturated
+  // against each group's top speed.
+  void moveVelocity(const HolonomicSpeeds& speeds);
+  HDriveKinematics getKinematics() const;
+
+ protected:
+  void applySensorReset() override;
+  void sampleSensors() override;
+  bool runMotion(const Pose& pose) override;
+  void moveWheels(const HDriveVelocities& velocities);
+  void driveWheels(double left, double right, double strafe);
+  QSpeed getTopStrafeSpeed() const;
+  MotorGroup strafeMotors;
+  double strafeGearRatio = 1;
+  double strafeWheelCircumference = 0;
+  double strafeScale = 1;
+  double strafeDriverOutput = 0;
+};
+}  // namespace apollo
@@ -0,0 +1,48 @@
+#pragma once
+#include "apollo/units/QAngle.hpp"
+#include "apollo/units/QAngularAcceleration.hpp"
+#include "apollo/units/QAngularSpeed.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+// Two state (heading, turn rate) Kalman filter that fuses the IMU heading and
+// gyro rate with the turn rate implied by the tracking wheels. Wheel
+// readings that disagree with the prediction by more than the gate are
+// treated as slip and dropped. Fixed size, no allocation.
+class HeadingFilter {
+ public:
+  // Standard deviations of each noise source.
+  struct Noise {
+    QAngularAcceleration process = 10 * radian / (second * second);
+    QAngle imuHeading = 2 * degree;
+    QAngularSpeed gyroRate = 2 * degree / second;
+    QAngularSpeed wheelRate = 5 * degree / second;
+    double slipGate = 3;
+  };
+  HeadingFilter() = default;
+  explicit HeadingFilter(Noise noise);
+  void setNoise(Noise noise);
+  Noise getNoise() const;
+  void reset(QAngle heading);
+  void predict(QTime deltaTime);
+  void updateHeading(QAngle heading);
+  void updateGyroRate(QAngularSpeed rate);
+  // Returns false when the reading was rejected as wheel slip.
+  bool updateWheelRate(QAngularSpeed rate);
+  QAngle getHeading() const;
+  QAngularSpeed getRate() const;
+
+ protected:
+  bool correct(QAngle measurement, QAngle deviation, double gate);
+  bool correct(QAngularSpeed measurement, QAngularSpeed deviation,
+               double gate);
+  bool correctState(int state, double innovation, double variance,
+                    double gate);
+  Noise noise;
+  QAngle heading;
+  QAngularSpeed rate;
+  // Entries are rad^2, rad^2/s and rad^2/s^2. An RQuantity array can only
+  // hold one unit, so the covariance is kept raw in SI units.
+  double covariance[2][2] = {{1, 0}, {0, 1}};
+};
+}  // namespace apollo
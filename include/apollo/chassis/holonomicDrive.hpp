@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "apollo/chassis/basicChassis.hpp"
+#include "apollo/chassis/chassis.hpp"
+#include "apollo/chassis/controlLoop.hpp"
+
+namespace apollo {
+// Chassis adapter over a BasicChassis, for code that picks its drive at
+// runtime and for ControlLoop. Each call forwards to the BasicChassis, so
+// a tick costs one virtual call into otherwise inlined code.
+template <typename Kinematics, typename Trackers = MotorTrackers>
+class HolonomicDrive : public Chassis,
+                       public BasicChassis<Kinematics, Trackers> {
+  using Basic = BasicChassis<Kinematics, Trackers>;
+
+ public:
+  using Basic::Basic;
+  void update() override { Basic::update(); }
+  void resetSensors() override { Basic::resetSensors(); }
+  void setBrakeMode(motor_brake_mode_e_t mode) override {
+    Basic::setBrakeMode(mode);
+  }
+  void setGearing(double gearing) override { Basic::setGearing(gearing); }
+  // Odometry always reads the drive motors in degrees.
+  void setEncoderUnits(double) override {}
+  void setMaxVelocity(double velocity) override {
+    Basic::setMaxVelocity(velocity);
+  }
+  void setMaxVoltage(double voltage) override {
+    Basic::setMaxVoltage(voltage);
+  }
+  MotionHandle setDrivePID(QLength targetDistance,
+                           QSpeed targetVelocity) override {
+    return Basic::setDrivePID(targetDistance, targetVelocity);
+  }
+  MotionHandle setTurnPID(QAngle targetAngle,
+                          QAngularSpeed targetVelocity) override {
+    return Basic::setTurnPID(targetAngle, targetVelocity);
+  }
+  MotionHandle setSwingPID(direction targetDirection, QAngle targetAngle,
+                           QAngularSpeed targetVelocity) override {
+    return Basic::setSwingPID(targetDirection, targetAngle, targetVelocity);
+  }
+  void setTank(controller_analog_e_t leftAxis,
+               controller_analog_e_t rightAxis,
+               controller_analog_e_t* strafeAxis) override {
+    Basic::setTank(leftAxis, rightAxis, strafeAxis);
+  }
+  void setArcade(controller_analog_e_t leftAxis,
+                 controller_analog_e_t rightAxis,
+                 controller_analog_e_t* strafeAxis) override {
+    Basic::setArcade(leftAxis, rightAxis, strafeAxis);
+  }
+  motor_brake_mode_e_t getBrakeMode() const override {
+    return Basic::getBrakeMode();
+  }
+  double getGearing() const override { return Basic::getGearing(); }
+  double getEncoderUnits() const override { return Basic::getEncoderUnits(); }
+  double getMaxVelocity() const override { return Basic::getMaxVelocity(); }
+  double getMaxVoltage() const override { return Basic::getMaxVoltage(); }
+  void startTracking(
+      ControlLoop::loopPeriod period = ControlLoop::period_10ms) {
+    stopTracking();
+    controlLoop = std::make_unique<ControlLoop>(*this, period);
+    controlLoop->start();
+  }
+  void stopTracking() {
+    if (controlLoop) {
+      controlLoop->stop();
+      controlLoop.reset();
+    }
+  }
+
+ protected:
+  std::unique_ptr<ControlLoop> controlLoop;
+};
+}  // namespace apollo
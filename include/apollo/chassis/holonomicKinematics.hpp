@@ -0,0 +1,229 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "apollo/units/QAngle.hpp"
+#include "apollo/units/QAngularSpeed.hpp"
+#include "apollo/units/QLength.hpp"
+#include "apollo/units/QSpeed.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+// Robot-relative chassis velocity. strafe is positive to the right and
+// angular counter-clockwise.
+struct HolonomicSpeeds {
+  QSpeed forward;
+  QSpeed strafe;
+  QAngularSpeed angular;
+};
+
+// Wheel surface speeds, positive when the wheel drives the robot forward.
+struct FourWheelVelocities {
+  QSpeed frontLeft;
+  QSpeed frontRight;
+  QSpeed backLeft;
+  QSpeed backRight;
+};
+
+// Kinematics shared by drives with four wheels whose rollers point along
+// the diagonals: X-drives and mecanum drives. translationScale is the wheel
+// speed per unit of robot translation, 1/sqrt(2) for an X-drive and 1 for
+// mecanum. turnRadius is the wheel speed per radian per second of rotation,
+// the distance from the tracking center to each wheel for an X-drive and
+// half the track width plus half the wheelbase for mecanum.
+// Both directions are fixed arithmetic with no branches.
+//
+// This and AsteriskKinematics are BasicChassis kinematics policies: the
+// wheel list, which side each wheel's motors report on, array conversions
+// and the virtual tank sides motions drive (see BasicChassis).
+class FourWheelKinematics {
+ public:
+  using Wheels = FourWheelVelocities;
+  static constexpr std::size_t wheelCount = 4;
+  static constexpr std::array<bool, wheelCount> leftWheels{true, false, true,
+                                                           false};
+  constexpr FourWheelKinematics(double translationScale, QLength turnRadius)
+      : translationScale(translationScale), turnRadius(turnRadius) {}
+  static constexpr std::array<QSpeed, wheelCount> toArray(
+      const Wheels& wheels) {
+    return {wheels.frontLeft, wheels.frontRight, wheels.backLeft,
+            wheels.backRight};
+  }
+  static constexpr Wheels fromArray(
+      const std::array<QSpeed, wheelCount>& wheels) {
+    return {wheels[0], wheels[1], wheels[2], wheels[3]};
+  }
+  constexpr FourWheelVelocities inverse(const HolonomicSpeeds& speeds) const {
+    QSpeed plus = (speeds.forward + speeds.strafe) * translationScale;
+    QSpeed minus = (speeds.forward - speeds.strafe) * translationScale;
+    QSpeed turn = (speeds.angular.convert(radps) * turnRadius) / second;
+    return {plus - turn, minus + turn, minus - turn, plus + turn};
+  }
+  constexpr HolonomicSpeeds forward(const FourWheelVelocities& wheels) const {
+    return {(wheels.frontLeft + wheels.frontRight + wheels.backLeft +
+             wheels.backRight) /
+                (4 * translationScale),
+            (wheels.frontLeft - wheels.frontRight - wheels.backLeft +
+             wheels.backRight) /
+                (4 * translationScale),
+            ((wheels.frontRight - wheels.frontLeft + wheels.backRight -
+              wheels.backLeft) /
+             (4 * turnRadius)) *
+                radian};
+  }
+  constexpr double getTranslationScale() const { return translationScale; }
+  constexpr QLength getTurnRadius() const { return turnRadius; }
+  // Side travel is the robot's forward travel on the left and right
+  // wheels, so a forward drive turns the wheels translationScale slower.
+  constexpr QLength getSideRadius() const {
+    return turnRadius / translationScale;
+  }
+  constexpr double getSideScale() const { return 1 / translationScale; }
+  constexpr double getStrafeScale() const { return 1 / translationScale; }
+
+ protected:
+  double translationScale;
+  QLength turnRadius;
+};
+
+// An H-drive: tank sides plus a strafe wheel group across the middle.
+struct HDriveVelocities {
+  QSpeed left;
+  QSpeed right;
+  QSpeed strafe;
+};
+
+class HDriveKinematics {
+ public:
+  constexpr explicit HDriveKinematics(QLength trackWidth)
+      : trackWidth(trackWidth) {}
+  constexpr HDriveVelocities inverse(const HolonomicSpeeds& speeds) const {
+    QSpeed turn = (speeds.angular.convert(radps) * trackWidth / 2) / second;
+    return {speeds.forward - turn, speeds.forward + turn, speeds.strafe};
+  }
+  constexpr HolonomicSpeeds forward(const HDriveVelocities& wheels) const {
+    return {(wheels.left + wheels.right) / 2, wheels.strafe,
+            ((wheels.right - wheels.left) / trackWidth) * radian};
+  }
+  constexpr QLength getTrackWidth() const { return trackWidth; }
+
+ protected:
+  QLength trackWidth;
+};
+
+// An asterisk drive: X-drive corner wheels plus a forward facing wheel in
+// the middle of each side. middleRadius is the distance from the tracking
+// center to each middle wheel.
+struct SixWheelVelocities {
+  FourWheelVelocities corners;
+  QSpeed middleLeft;
+  QSpeed middleRight;
+};
+
+class AsteriskKinematics {
+ public:
+  using Wheels = SixWheelVelocities;
+  static constexpr std::size_t wheelCount = 6;
+  static constexpr std::array<bool, wheelCount> leftWheels{
+      true, false, true, false, true, false};
+  constexpr AsteriskKinematics(QLength cornerRadius, QLength middleRadius)
+      : corners(M_SQRT1_2, cornerRadius), middleRadius(middleRadius) {}
+  static constexpr std::array<QSpeed, wheelCount> toArray(
+      const Wheels& wheels) {
+    return {wheels.corners.frontLeft, wheels.corners.frontRight,
+            wheels.corners.backLeft,  wheels.corners.backRight,
+            wheels.middleLeft,        wheels.middleRight};
+  }
+  static constexpr Wheels fromArray(
+      const std::array<QSpeed, wheelCount>& wheels) {
+    return {{wheels[0], wheels[1], wheels[2], wheels[3]}, wheels[4], wheels[5]};
+  }
+  constexpr SixWheelVelocities inverse(const HolonomicSpeeds& speeds) const {
+    QSpeed turn = (speeds.angular.convert(radps) * middleRadius) / second;
+    return {corners.inverse(speeds), speeds.forward - turn,
+            speeds.forward + turn};
+  }
+  // Least squares over all six wheels. Strafe only comes from the corners,
+  // forward and turn weigh every wheel by how much it moves with them.
+  constexpr HolonomicSpeeds forward(const SixWheelVelocities& wheels) const {
+    const FourWheelVelocities& c = wheels.corners;
+    double scale = corners.getTranslationScale();
+    double radius = corners.getTurnRadius().convert(meter);
+    double middle = middleRadius.convert(meter);
+    QSpeed cornerForward =
+        c.frontLeft + c.frontRight + c.backLeft + c.backRight;
+    QSpeed cornerTurn = c.frontRight - c.frontLeft + c.backRight - c.backLeft;
+    QSpeed middleTurn = wheels.middleRight - wheels.middleLeft;
+    return {(cornerForward * scale + wheels.middleLeft + wheels.middleRight) /
+                (4 * scale * scale + 2),
+            corners.forward(c).strafe,
+            ((cornerTurn * radius + middleTurn * middle).convert(mps) /
+             (4 * radius * radius + 2 * middle * middle)) *
+                radps};
+  }
+  constexpr const FourWheelKinematics& getCorners() const { return corners; }
+  constexpr QLength getMiddleRadius() const { return middleRadius; }
+  // Motions drive the middle wheels as tank sides. They face forward, so
+  // they reach the top wheel speed before the corners do.
+  constexpr QLength getSideRadius() const { return middleRadius; }
+  constexpr double getSideScale() const { return 1; }
+  constexpr double getStrafeScale() const {
+    return corners.getStrafeScale();
+  }
+
+ protected:
+  FourWheelKinematics corners;
+  QLength middleRadius;
+};
+
+// Scales every wheel down together when one would exceed maxSpeed, so the
+// direction of motion is kept. Takes a kinematics policy's toArray wheels.
+template <std::size_t wheelCount>
+inline std::array<QSpeed, wheelCount> desaturate(
+    const std::array<QSpeed, wheelCount>& wheels, QSpeed maxSpeed) {
+  double limit = maxSpeed.convert(mps);
+  double peak = 0;
+  for (const QSpeed& wheel : wheels) {
+    peak = std::fmax(peak, std::fabs(wheel.convert(mps)));
+  }
+  double scale = peak > limit ? limit / peak : 1;
+  std::array<QSpeed, wheelCount> scaled;
+  for (std::size_t i = 0; i < wheelCount; i++) {
+    scaled[i] = wheels[i] * scale;
+  }
+  return scaled;
+}
+
+// H-drive sides and strafe wheels have their own top speeds; all three
+// are scaled together. As with the array overload, a wheel asked to move
+// past a zero top speed stops all of them.
+inline HDriveVelocities desaturate(const HDriveVelocities& wheels,
+                                   QSpeed maxSideSpeed,
+                                   QSpeed maxStrafeSpeed) {
+  auto ratio = [](QSpeed wheel, QSpeed maxSpeed) {
+    double speed = std::fabs(wheel.convert(mps));
+    double limit = maxSpeed.convert(mps);
+    if (limit <= 0) {
+      return speed > 0 ? INFINITY : 0.0;
+    }
+    return speed / limit;
+  };
+  double peak = std::fmax(std::fmax(ratio(wheels.left, maxSideSpeed),
+                                    ratio(wheels.right, maxSideSpeed)),
+                          ratio(wheels.strafe, maxStrafeSpeed));
+  double scale = 1 / std::fmax(1, peak);
+  return {wheels.left * scale, wheels.right * scale, wheels.strafe * scale};
+}
+
+// Turns a field-relative command into the robot's frame. heading is the
+// counter-clockwise robot angle from the direction the command's forward
+// points along.
+inline HolonomicSpeeds toRobotFrame(const HolonomicSpeeds& speeds,
+                                    QAngle heading) {
+  double cosine = std::cos(heading.convert(radian));
+  double sine = std::sin(heading.convert(radian));
+  return {speeds.forward * cosine - speeds.strafe * sine,
+          speeds.forward * sine + speeds.strafe * cosine, speeds.angular};
+}
+}  // namespace apollo
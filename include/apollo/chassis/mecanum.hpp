@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+#include "apollo/chassis/holonomicDrive.hpp"
+
+namespace apollo {
+// Four mecanum wheels with their rollers forming an X seen from above.
+// Strafing loses some speed to roller slip, which the drive motor odometry
+// can't see; use HolonomicDrive<FourWheelKinematics, RotationTrackers> with
+// mecanumKinematics to track with wheels instead.
+class Mecanum : public HolonomicDrive<FourWheelKinematics> {
+ public:
+  // trackWidth is measured between the left and right wheels, wheelBase
+  // between the front and back ones.
+  Mecanum(std::vector<int> frontLeftMotorPorts,
+          std::vector<int> frontRightMotorPorts,
+          std::vector<int> backLeftMotorPorts,
+          std::vector<int> backRightMotorPorts, int inertialSensorPort,
+          double cartridgeRPM, double gearRatio, double wheelDiameter,
+          QLength trackWidth, QLength wheelBase);
+  void setDimensions(QLength trackWidth, QLength wheelBase);
+};
+
+// Each wheel's rollers push at 45 degrees, so translation moves the wheel
+// at full robot speed and a turn at the sum of its offsets from the center.
+constexpr FourWheelKinematics mecanumKinematics(QLength trackWidth,
+                                                QLength wheelBase) {
+  return {1, (trackWidth + wheelBase) / 2};
+}
+}  // namespace apollo
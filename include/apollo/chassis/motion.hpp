@@ -0,0 +1,94 @@
+#pragma once
+#include <atomic>
+#include <memory>
+
+#include "apollo/chassis/exitConditions.hpp"
+#include "apollo/chassis/pose.hpp"
+#include "apollo/chassis/sensorFrame.hpp"
+#include "apollo/units/QAngle.hpp"
+#include "apollo/units/QLength.hpp"
+#include "apollo/units/QSpeed.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+// Everything a motion needs from one control tick.
+struct MotionContext {
+  const SensorFrame& frame;
+  Pose pose;
+  QLength leftDistance;
+  QLength rightDistance;
+  QSpeed leftVelocity;
+  QSpeed rightVelocity;
+  QTime timestamp;
+};
+
+// Drive side outputs in millivolts.
+struct DriveOutput {
+  double left = 0;
+  double right = 0;
+};
+
+// Shared between the chassis task running a motion and the handles
+// returned to the caller. progress is in meters or radians, exitTime in
+// seconds from the start of the motion.
+struct MotionState {
+  std::atomic<bool> settled{false};
+  std::atomic<bool> cancelled{false};
+  std::atomic<double> progress{0};
+  std::atomic<exitReason> reason{exit_none};
+  std::atomic<double> exitTime{0};
+};
+
+class Motion {
+ public:
+  Motion();
+  virtual ~Motion() = default;
+  virtual void start(const MotionContext& context);
+  // Called every tick until the motion marks itself settled.
+  virtual DriveOutput step(const MotionContext& context) = 0;
+  std::shared_ptr<MotionState> getState() const;
+  void setExitConditions(const ExitConditions& conditions);
+  // A chained motion hands off to the next one as soon as it is inside
+  // its large error window, without waiting to stop. Can be changed while
+  // the motion runs.
+  void setChained(bool chained);
+  bool isChained() const;
+  // Signed forward speed the motion hands off to the next one at when
+  // chained. Zero unless the motion plans to be moving when it ends.
+  virtual QSpeed getHandoffVelocity() const;
+  // Ends the motion from the chassis task, recording why and when.
+  void settle(exitReason reason, QTime timestamp);
+
+ protected:
+  // Runs the exit conditions on this tick's error, settling the motion
+  // once one of them is met.
+  bool updateSettled(double error, const MotionContext& context);
+  std::shared_ptr<MotionState> state;
+  QTime startTime;
+  QTime lastTime;
+  ExitConditions exitConditions = defaultDriveExit;
+  ExitConditionMonitor exitMonitor;
+  std::atomic<bool> chained{false};
+  // Time the motion is planned to take, added to the timeout.
+  QTime expectedDuration;
+};
+
+class MotionHandle {
+ public:
+  MotionHandle() = default;
+  explicit MotionHandle(std::shared_ptr<MotionState> state);
+  void waitUntilSettled() const;
+  // Blocks until the motion has covered the distance or angle, or ended.
+  void waitUntil(QLength distance) const;
+  void waitUntil(QAngle angle) const;
+  void cancel();
+  bool isSettled() const;
+  double getProgress() const;
+  exitReason getExitReason() const;
+  QTime getExitTime() const;
+
+ private:
+  void waitUntilProgress(double progress) const;
+  std::shared_ptr<MotionState> state;
+};
+}  // namespace apollo
@@ -0,0 +1,74 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "apollo/chassis/motionRunner.hpp"
+#include "apollo/chassis/motions.hpp"
+#include "apollo/control/profileCache.hpp"
+#include "apollo/trajectory/trajectory.hpp"
+#include "apollo/units/QDirection.hpp"
+
+namespace apollo {
+// What the motions need to know about a chassis driven like a tank: the
+// top speed of a side, the distance between the sides and the output cap.
+// Chassis pass their current values with every command.
+struct SideModel {
+  QSpeed topSpeed;
+  QLength trackWidth;
+  double maxVoltage;
+};
+
+// The drive, turn, swing, path and trajectory commands shared by every
+// chassis, with the gains, limits and exit conditions they are built
+// from. Commands are built in the caller's task and handed to the
+// MotionRunner, which the chassis runs from its control task.
+class MotionCommands {
+ public:
+  MotionHandle drive(QLength targetDistance, QSpeed targetVelocity,
+                     const SideModel& sides);
+  MotionHandle turn(QAngle targetAngle, QAngularSpeed targetVelocity,
+                    const SideModel& sides);
+  MotionHandle swing(direction targetDirection, QAngle targetAngle,
+                     QAngularSpeed targetVelocity, const SideModel& sides);
+  MotionHandle followPath(std::vector<Waypoint> path, QLength lookahead,
+                          QSpeed targetVelocity, const SideModel& sides);
+  MotionHandle followTrajectory(
+      std::shared_ptr<const TrajectorySource> trajectory,
+      const SideModel& sides);
+  MotionHandle start(std::shared_ptr<Motion> motion);
+  void cancel();
+  void beginChain(QSpeed handoffVelocity);
+  void endChain();
+  // Called once per tick from the control task, see MotionRunner::run.
+  bool run(const MotionContext& context, DriveOutput& output);
+
+  void setDriveGains(PIDGains gains);
+  void setHeadingGains(PIDGains gains);
+  void setTurnGains(PIDGains gains);
+  void setSwingGains(PIDGains gains);
+  void setRamseteGains(double b, double zeta);
+  void setDriveConstraints(QAcceleration acceleration, QJerk jerk);
+  void setFeedforward(FeedforwardGains gains);
+  // Until gains are set, voltage is scaled linearly from the top speed.
+  Feedforward getFeedforward(const SideModel& sides) const;
+  void setDriveExitConditions(const ExitConditions& conditions);
+  void setTurnExitConditions(const ExitConditions& conditions);
+
+ private:
+  MotionHandle start(std::shared_ptr<Motion> motion,
+                     const ExitConditions& conditions);
+  static double outputForSpeed(QSpeed sideSpeed, const SideModel& sides);
+  PIDGains driveGains{30000, 0, 1500};
+  PIDGains headingGains{20000, 0, 0};
+  PIDGains turnGains{15000, 0, 1000};
+  PIDGains swingGains{20000, 0, 1000};
+  ExitConditions driveExit = defaultDriveExit;
+  ExitConditions turnExit = defaultTurnExit;
+  RamseteController ramseteController;
+  FeedforwardGains feedforwardGains;
+  QAcceleration driveAcceleration = 2 * mps2;
+  QJerk driveJerk;
+  ProfileCache<8> profileCache;
+  MotionRunner motionRunner;
+};
+}  // namespace apollo
@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <deque>
+#include <memory>
+
+#include "apollo/chassis/motion.hpp"
+#include "apollo/units/QSpeed.hpp"
+#include "pros/rtos.hpp"
+
+namespace apollo {
+// Hands motions from the caller's task to the chassis control task and
+// runs them there. start, cancel and the chain calls come from user code;
+// run is called once per tick by the chassis.
+class MotionRunner {
+ public:
+  MotionHandle start(std::shared_ptr<Motion> motion);
+  void cancel();
+  // Between beginChain and endChain, started motions queue behind each
+  // other instead of replacing the running motion. Every motion but the
+  // last hands off to the next without stopping, drives at
+  // handoffVelocity.
+  void beginChain(QSpeed handoffVelocity);
+  void endChain();
+  QSpeed getChainVelocity() const;
+  // Signed speeds a drive over distance started now is handed over at and
+  // hands off at, for solving its profiles before it is queued. Inside a
+  // chain they are the last queued motion's handoff speed and the chain
+  // velocity; outside one the drive runs from and to rest.
+  void getChainSpeeds(QLength distance, QSpeed& entryVelocity,
+                      QSpeed& handoffVelocity);
+  // Steps the active motion. Returns false when no motion ran this tick,
+  // so the chassis leaves its motors to driver control.
+  bool run(const MotionContext& context, DriveOutput& output);
+
+ protected:
+  std::shared_ptr<Motion> popQueued(const MotionContext& context);
+  void clearQueued();
+  pros::Mutex mutex;
+  std::atomic<bool> cancelRequested{false};
+  std::shared_ptr<Motion> pendingMotion;
+  std::shared_ptr<Motion> activeMotion;
+  std::deque<std::shared_ptr<Motion>> queuedMotions;
+  std::shared_ptr<Motion> lastChained;
+  bool chaining = false;
+  QSpeed chainVelocity;
+};
+}  // namespace apollo
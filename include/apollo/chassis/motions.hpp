@@ -0,0 +1,117 @@
+#pragma once
+#include "apollo/chassis/motion.hpp"
+#include "apollo/control/feedforward.hpp"
+#include "apollo/control/motionProfile.hpp"
+#include "apollo/control/pidController.hpp"
+#include "apollo/control/purePursuit.hpp"
+#include "apollo/control/ramsete.hpp"
+#include "apollo/trajectory/trajectory.hpp"
+#include "apollo/units/QDirection.hpp"
+
+namespace apollo {
+// Differential drive motions. Angles are absolute, counter-clockwise
+// headings in the odometry frame; turns and swings go the shortest way
+// round to them, so 270 degrees and -90 degrees are the same target.
+// maxOutput caps each side in millivolts.
+// DriveMotion tracks the profile's position setpoint rather than the final
+// distance, so the drive PID never sees the whole move as error at once,
+// and feeds the profile's velocity and acceleration forward.
+class DriveMotion : public Motion {
+ public:
+  // stopProfile ends at rest and handoffProfile at the speed a chained
+  // drive hands off at. Both are solved by the caller from the speed the
+  // drive is handed over at, so starting it only picks one.
+  DriveMotion(const MotionProfile& stopProfile,
+              const MotionProfile& handoffProfile, double maxOutput,
+              PIDGains driveGains, PIDGains headingGains,
+              Feedforward feedforward = Feedforward());
+  // A drive from rest to rest that never hands off moving.
+  DriveMotion(const MotionProfile& profile, double maxOutput,
+              PIDGains driveGains, PIDGains headingGains,
+              Feedforward feedforward = Feedforward());
+  void start(const MotionContext& context) override;
+  DriveOutput step(const MotionContext& context) override;
+  QSpeed getHandoffVelocity() const override;
+
+ private:
+  MotionProfile profile;
+  MotionProfile stopProfile;
+  MotionProfile handoffProfile;
+  Feedforward feedforward;
+  QLength distance;
+  double maxOutput;
+  PIDController<QLength> drivePID;
+  PIDController<QAngle> headingPID;
+  QLength startLeft;
+  QLength startRight;
+  QAngle targetHeading;
+};
+
+class TurnMotion : public Motion {
+ public:
+  TurnMotion(QAngle targetAngle, double maxOutput, PIDGains turnGains);
+  void start(const MotionContext& context) override;
+  DriveOutput step(const MotionContext& context) override;
+
+ private:
+  QAngle targetAngle;
+  double maxOutput;
+  PIDController<QAngle> turnPID;
+  QAngle startAngle;
+};
+
+// Turns by driving one side only. LEFT drives the left side and pivots
+// around the right wheels, RIGHT the opposite; the pivot side holds its
+// position.
+class SwingMotion : public Motion {
+ public:
+  SwingMotion(direction side, QAngle targetAngle, double maxOutput,
+              PIDGains swingGains, PIDGains holdGains);
+  void start(const MotionContext& context) override;
+  DriveOutput step(const MotionContext& context) override;
+
+ private:
+  direction side;
+  QAngle targetAngle;
+  double maxOutput;
+  PIDController<QAngle> swingPID;
+  PIDController<QLength> holdPID;
+  QAngle startAngle;
+  QLength startLeft;
+  QLength startRight;
+};
+
+// Follows a waypoint path with pure pursuit. The drive PID acts on the
+// distance left along the path and the curvature splits it between sides.
+class PathMotion : public Motion {
+ public:
+  PathMotion(std::vector<Waypoint> path, QLength lookahead,
+             QLength trackWidth, double maxOutput, PIDGains driveGains);
+  void start(const MotionContext& context) override;
+  DriveOutput step(const MotionContext& context) override;
+
+ private:
+  PurePursuit pursuit;
+  QLength trackWidth;
+  double maxOutput;
+  PIDController<QLength> drivePID;
+};
+
+// Tracks a time-parameterized trajectory with RAMSETE. Wheel velocities
+// are turned into millivolts by the feedforward model, and the motion
+// settles once the trajectory has run out and the robot is on its end.
+class TrajectoryMotion : public Motion {
+ public:
+  TrajectoryMotion(std::shared_ptr<const TrajectorySource> trajectory,
+                   RamseteController controller, QLength trackWidth,
+                   Feedforward feedforward, double maxOutput);
+  DriveOutput step(const MotionContext& context) override;
+
+ private:
+  std::shared_ptr<const TrajectorySource> trajectory;
+  RamseteController controller;
+  QLength trackWidth;
+  Feedforward feedforward;
+  double maxOutput;
+};
+}  // namespace apollo
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "apollo/units/QAngle.hpp"
+#include "apollo/units/QAngularSpeed.hpp"
+#include "pros/motors.hpp"
+
+namespace apollo {
+// Commands every motor on one side of a drive at once. Repeated commands
+// with an unchanged value are dropped so they don't cost smart port traffic.
+class MotorGroup {
+ public:
+  MotorGroup() = default;
+  MotorGroup(std::vector<int> motorPorts);
+  void moveVoltage(std::int32_t voltage);
+  void moveVelocity(std::int32_t velocity);
+  void setBrakeMode(pros::motor_brake_mode_e_t mode);
+  // Per motor current limit in milliamps.
+  void setCurrentLimit(std::int32_t limit);
+  void setEncoderUnits(pros::motor_encoder_units_e_t units);
+  void tarePosition();
+  void invalidate();
+  QAngle getPosition() const;
+  QAngularSpeed getVelocity() const;
+  std::int32_t getCurrentDraw() const;
+  pros::motor_brake_mode_e_t getBrakeMode() const;
+  std::size_t size() const;
+  pros::Motor& operator[](std::size_t index);
+  const pros::Motor& operator[](std::size_t index) const;
+  std::vector<pros::Motor>::iterator begin();
+  std::vector<pros::Motor>::iterator end();
+
+ protected:
+  enum commandMode { command_none, command_voltage, command_velocity };
+  std::vector<pros::Motor> motors;
+  commandMode lastCommandMode = command_none;
+  std::int32_t lastCommand = 0;
+  pros::motor_brake_mode_e_t brakeMode = pros::E_MOTOR_BRAKE_INVALID;
+  std::int32_t currentLimit = -1;
+};
+}  // namespace apollo
@@ -0,0 +1,48 @@
+#pragma once
+#include "apollo/chassis/pose.hpp"
+#include "apollo/units/QAngle.hpp"
+#include "apollo/units/QLength.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+// Arc-based pose integration from two parallel trackers and an optional
+// perpendicular one. left and right are the sideways distances from the
+// tracking center to each parallel tracker, center is the distance of the
+// perpendicular tracker behind it. The perpendicular tracker counts positive
+// when the robot moves left.
+class Odometry {
+ public:
+  struct TrackerOffsets {
+    QLength left;
+    QLength right;
+    QLength center;
+  };
+  Odometry() = default;
+  explicit Odometry(TrackerOffsets offsets);
+  void setOffsets(TrackerOffsets offsets);
+  TrackerOffsets getOffsets() const;
+  // Tracker arguments are the distances travelled since the last reset.
+  // Without a heading the rotation is taken from the parallel trackers,
+  // otherwise heading is the absolute counter-clockwise robot angle.
+  void update(QLength left, QLength right, QLength center, QTime timestamp);
+  void update(QLength left, QLength right, QLength center, QAngle heading,
+              QTime timestamp);
+  void setPose(const Pose& newPose);
+  void reset();
+  Pose getPose() const;
+  QLength getX() const;
+  QLength getY() const;
+  QAngle getTheta() const;
+
+ protected:
+  void integrate(QLength deltaLeft, QLength deltaRight, QLength deltaCenter,
+                 QAngle deltaTheta, QTime timestamp);
+  TrackerOffsets offsets;
+  Pose pose;
+  QLength lastLeft;
+  QLength lastRight;
+  QLength lastCenter;
+  QAngle lastHeading;
+  bool initialized = false;
+};
+}  // namespace apollo
@@ -0,0 +1,17 @@
+#pragma once
+#include "apollo/units/QAngle.hpp"
+#include "apollo/units/QLength.hpp"
+#include "apollo/units/QTime.hpp"
+#include "apollo/util/tripleBuffer.hpp"
+
+namespace apollo {
+// Field-relative robot pose. theta is counter-clockwise from the +x axis.
+struct Pose {
+  QLength x;
+  QLength y;
+  QAngle theta;
+  QTime timestamp;
+};
+
+using PoseBuffer = util::TripleBuffer<Pose>;
+}  // namespace apollo
@@ -0,0 +1,87 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+#include "apollo/chassis/pose.hpp"
+
+namespace apollo {
+// Fixed capacity ring of timestamped poses, oldest overwritten first. Poses
+// must be pushed in timestamp order, which keeps the ring sorted and lets
+// lookups binary search it. theta is continuous, so it is interpolated
+// linearly like x and y.
+template <std::size_t Capacity>
+class PoseHistory {
+  static_assert(Capacity >= 2, "PoseHistory needs at least two entries");
+
+ public:
+  // Returns false and drops the pose if it is older than the newest entry.
+  bool push(const Pose& pose) {
+    if (count > 0 && pose.timestamp < newest().timestamp) {
+      return false;
+    }
+    poses[(start + count) % Capacity] = pose;
+    if (count < Capacity) {
+      count++;
+    } else {
+      start = (start + 1) % Capacity;
+    }
+    return true;
+  }
+
+  // Pose at an arbitrary timestamp, interpolated between the two entries
+  // around it and clamped to the oldest/newest entry outside the range.
+  bool sample(QTime timestamp, Pose& pose) const {
+    if (count == 0) {
+      return false;
+    }
+    if (timestamp <= oldest().timestamp) {
+      pose = oldest();
+      return true;
+    }
+    if (timestamp >= newest().timestamp) {
+      pose = newest();
+      return true;
+    }
+    // First entry newer than the timestamp.
+    std::size_t low = 1;
+    std::size_t high = count - 1;
+    while (low < high) {
+      std::size_t middle = low + (high - low) / 2;
+      if ((*this)[middle].timestamp > timestamp) {
+        high = middle;
+      } else {
+        low = middle + 1;
+      }
+    }
+    const Pose& before = (*this)[low - 1];
+    const Pose& after = (*this)[low];
+    double fraction = ((timestamp - before.timestamp) /
+                       (after.timestamp - before.timestamp))
+                          .getValue();
+    pose.x = before.x + (after.x - before.x) * fraction;
+    pose.y = before.y + (after.y - before.y) * fraction;
+    pose.theta = before.theta + (after.theta - before.theta) * fraction;
+    pose.timestamp = timestamp;
+    return true;
+  }
+
+  // Index 0 is the oldest entry.
+  const Pose& operator[](std::size_t index) const {
+    return poses[(start + index) % Capacity];
+  }
+  const Pose& oldest() const { return (*this)[0]; }
+  const Pose& newest() const { return (*this)[count - 1]; }
+  std::size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+  static constexpr std::size_t capacity() { return Capacity; }
+  void clear() {
+    start = 0;
+    count = 0;
+  }
+
+ private:
+  std::array<Pose, Capacity> poses;
+  std::size_t start = 0;
+  std::size_t count = 0;
+};
+}  // namespace apollo
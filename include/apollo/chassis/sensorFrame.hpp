@@ -0,0 +1,84 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+#include "apollo/units/QAcceleration.hpp"
+#include "apollo/units/QAngle.hpp"
+#include "apollo/units/QAngularSpeed.hpp"
+#include "apollo/units/QLength.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+struct MotorSample {
+  QAngle position;
+  QAngularSpeed velocity;
+  // Current draw in milliamps.
+  double current = 0;
+  // Untared encoder reading and the time the motor took it, only sampled
+  // for motor integrated tracking.
+  QAngle rawPosition;
+  QTime rawTimestamp;
+};
+
+struct GpsSample {
+  QLength x;
+  QLength y;
+  QLength error;
+  QTime timestamp;
+};
+
+// Snapshot of every chassis sensor, sampled once per control tick so that
+// odometry, control and telemetry all work from the same readings.
+struct SensorFrame {
+  static constexpr std::size_t maxSideMotors = 4;
+  QTime timestamp;
+  std::array<MotorSample, maxSideMotors> leftMotors;
+  std::array<MotorSample, maxSideMotors> rightMotors;
+  std::size_t leftMotorCount = 0;
+  std::size_t rightMotorCount = 0;
+  QAngle heading;
+  QAngle rotation;
+  QAngularSpeed headingRate;
+  // IMU acceleration towards the robot's front, only sampled with traction
+  // control on.
+  QAcceleration forwardAcceleration;
+  double leftTrackerCount = 0;
+  double rightTrackerCount = 0;
+  double centerTrackerCount = 0;
+  bool gpsSampled = false;
+  GpsSample gps;
+
+  QAngle leftPosition() const {
+    return meanPosition(leftMotors, leftMotorCount);
+  }
+  QAngle rightPosition() const {
+    return meanPosition(rightMotors, rightMotorCount);
+  }
+  QAngularSpeed leftVelocity() const {
+    return meanVelocity(leftMotors, leftMotorCount);
+  }
+  QAngularSpeed rightVelocity() const {
+    return meanVelocity(rightMotors, rightMotorCount);
+  }
+
+ private:
+  static QAngle meanPosition(
+      const std::array<MotorSample, maxSideMotors>& samples,
+      std::size_t count) {
+    QAngle total;
+    for (std::size_t i = 0; i < count; i++) {
+      total += samples[i].position;
+    }
+    return count == 0 ? total : total / static_cast<double>(count);
+  }
+  static QAngularSpeed meanVelocity(
+      const std::array<MotorSample, maxSideMotors>& samples,
+      std::size_t count) {
+    QAngularSpeed total;
+    for (std::size_t i = 0; i < count; i++) {
+      total += samples[i].velocity;
+    }
+    return count == 0 ? total : total / static_cast<double>(count);
+  }
+};
+}  // namespace apollo
@@ -0,0 +1,43 @@
+#pragma once
+#include "apollo/units/QAcceleration.hpp"
+#include "apollo/units/QSpeed.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+// Detects drive wheel slip by comparing the acceleration of the wheel
+// surface, from motor velocity, with the acceleration the IMU measures.
+// Wheels that spin up or keep turning faster than the robot can follow are
+// slipping. Both accelerations are smoothed, since differentiating wheel
+// speed is noisy, and the difference has to last holdTime before it
+// counts. Slip ends once the difference falls under half the threshold.
+class SlipDetector {
+ public:
+  struct Parameters {
+    QAcceleration threshold = 3 * mps2;
+    QTime holdTime = 40 * millisecond;
+    // Weight of each new sample in the exponential smoothing, 1 turns
+    // smoothing off.
+    double smoothing = 0.3;
+  };
+  SlipDetector();
+  explicit SlipDetector(Parameters parameters);
+  void setParameters(Parameters parameters);
+  // Call once per tick with the mean forward wheel surface speed and the
+  // IMU's forward acceleration. Returns whether the wheels are slipping.
+  bool update(QSpeed wheelSpeed, QAcceleration measuredAcceleration,
+              QTime timestamp);
+  bool isSlipping() const;
+  void reset();
+
+ protected:
+  Parameters parameters;
+  bool initialized = false;
+  bool slipping = false;
+  QSpeed lastWheelSpeed;
+  QTime lastTimestamp;
+  QAcceleration wheelAcceleration;
+  QAcceleration imuAcceleration;
+  QTime mismatchStart;
+  bool mismatched = false;
+};
+}  // namespace apollo
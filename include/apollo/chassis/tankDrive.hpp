@@ -1,14 +1,35 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
+#include "apollo/chassis/characterization.hpp"
 #include "apollo/chassis/chassis.hpp"
+#include "apollo/chassis/controlLoop.hpp"
+#include "apollo/chassis/currentBudget.hpp"
+#include "apollo/chassis/driveCurve.hpp"
+#include "apollo/chassis/gpsCorrection.hpp"
+#include "apollo/chassis/headingFilter.hpp"
+#include "apollo/chassis/motionCommands.hpp"
+#include "apollo/chassis/motions.hpp"
+#include "apollo/chassis/motorGroup.hpp"
+#include "apollo/chassis/odometry.hpp"
+#include "apollo/chassis/pose.hpp"
+#include "apollo/chassis/timestampAligner.hpp"
+#include "apollo/chassis/sensorFrame.hpp"
+#include "apollo/chassis/slipDetector.hpp"
+#include "apollo/trajectory/trajectory.hpp"
 #include "pros/adi.hpp"
+#include "pros/gps.hpp"
 #include "pros/imu.hpp"
 #include "pros/motors.hpp"
 #include "pros/rotation.hpp"
+#include "pros/rtos.hpp"
 
 namespace apollo {
 class Tank : public Chassis {
  public:
+  enum imuAxis { imu_x, imu_y, imu_negative_x, imu_negative_y };
   Tank(std::vector<int> leftDriveMotorPorts,
        std::vector<int> rightDriveMotorPorts, int inertialSensorPort,
        double cartridgeRPM, double gearRatio, double wheelDiameter);
@@ -25,16 +46,142 @@ class Tank : public Chassis {
        std::vector<int> centerEncoderTrackerPorts);
   Tank(std::vector<int> leftDriveMotorPorts,
        std::vector<int> rightDriveMotorPorts, int inertialSensorPort,
-       double cartridgeRPM, int leftRotationTrackerPorts,
-       int rightRotationTrackerPorts);
+       double cartridgeRPM, double gearRatio, double wheelDiameter,
+       int leftRotationTrackerPorts, int rightRotationTrackerPorts);
   Tank(std::vector<int> leftDriveMotorPorts,
        std::vector<int> rightDriveMotorPorts, int inertialSensorPort,
-       double cartridgeRPM, int leftRotationTrackerPorts,
-       int rightRotationTrackerPorts, int centerRotationTrackerPorts);
+       double cartridgeRPM, double gearRatio, double wheelDiameter,
+       int leftRotationTrackerPorts, int rightRotationTrackerPorts,
+       int centerRotationTrackerPorts);
+  void update() override;
+  void resetSensors() override;
+  void setBrakeMode(motor_brake_mode_e_t mode) override;
+  void setGearing(double gearing) override;
+  void setEncoderUnits(double units) override;
+  void setMaxVelocity(double velocity) override;
+  void setMaxVoltage(double voltage) override;
+  MotionHandle setDrivePID(QLength targetDistance,
+                           QSpeed targetVelocity) override;
+  MotionHandle setTurnPID(QAngle targetAngle,
+                          QAngularSpeed targetVelocity) override;
+  MotionHandle setSwingPID(direction targetDirection, QAngle targetAngle,
+                           QAngularSpeed targetVelocity) override;
+  // Driver control from the master controller, called from opcontrol while
+  // no motion is running. setTank drives each side from its axis, setArcade
+  // takes forward on leftAxis and turn on rightAxis. A tank can't strafe,
+  // so strafeAxis is ignored.
+  void setTank(controller_analog_e_t leftAxis,
+               controller_analog_e_t rightAxis,
+               controller_analog_e_t* strafeAxis) override;
+  void setArcade(controller_analog_e_t leftAxis,
+                 controller_analog_e_t rightAxis,
+                 controller_analog_e_t* strafeAxis) override;
+  motor_brake_mode_e_t getBrakeMode() const override;
+  double getGearing() const override;
+  double getEncoderUnits() const override;
+  double getMaxVelocity() const override;
+  double getMaxVoltage() const override;
+  void setDriveGains(PIDGains gains);
+  void setHeadingGains(PIDGains gains);
+  void setTurnGains(PIDGains gains);
+  void setSwingGains(PIDGains gains);
+  // The drive curve shapes the tank sides and arcade forward axis, the
+  // turn curve the arcade turn axis. Curves are kept by pointer and can be
+  // swapped at any time.
+  void setDriveCurve(const DriveCurve& curve);
+  void setTurnCurve(const DriveCurve& curve);
+  // Largest change in driver output per call, as a fraction of full
+  // power. Zero turns slew limiting off.
+  void setDriverSlew(double maxChange);
+  // Acceleration and jerk limits for setDrivePID profiles. A jerk of zero
+  // gives trapezoidal profiles.
+  void setDriveConstraints(QAcceleration acceleration,
+                           QJerk jerk = QJerk());
+  // Top wheel speed from getMaxVelocity and the measured track width.
+  TrajectoryConstraints getTrajectoryConstraints(
+      QAcceleration maxAcceleration) const;
+  // Follows the path from the robot's current pose with pure pursuit.
+  MotionHandle followPath(std::vector<Waypoint> path, QLength lookahead,
+                          QSpeed targetVelocity = QSpeed());
+  // Tracks the trajectory with RAMSETE. Its poses are field coordinates,
+  // so it should start at the robot's pose.
+  MotionHandle followTrajectory(
+      std::shared_ptr<const TrajectorySource> trajectory);
+  void setRamseteGains(double b, double zeta);
+  // Characterized drive side model, see CharacterizationMotion. Until one
+  // is set, voltage is scaled linearly from the top wheel speed.
+  void setFeedforward(FeedforwardGains gains);
+  Feedforward getFeedforward() const;
+  // Runs a CharacterizationSequence and blocks until it is done. The runs
+  // are logged under logPrefix when it is set, and a successful fit
+  // becomes the feedforward.
+  bool characterize(
+      const CharacterizationSettings& settings = CharacterizationSettings(),
+      const char* logPrefix = "/usd/characterization");
+  // Drive conditions cover drives, paths and trajectories, turn
+  // conditions turns and swings.
+  void setDriveExitConditions(const ExitConditions& conditions);
+  void setTurnExitConditions(const ExitConditions& conditions);
+  MotionHandle startMotion(std::shared_ptr<Motion> motion);
+  void cancelMotion();
+  // Between beginChain and endChain, motion commands queue behind each
+  // other instead of replacing the running motion. Every motion but the
+  // last hands off to the next without stopping, drives at
+  // handoffVelocity.
+  void beginChain(QSpeed handoffVelocity);
+  void endChain();
+  const SensorFrame& getSensorFrame() const;
+  Pose getPose() const;
+  void setPose(const Pose& pose);
+  void setTrackingOffsets(QLength left, QLength right,
+                          QLength center = 0 * meter);
+  void setTrackerWheel(QLength wheelDiameter, double gearRatio = 1);
+  void setHeadingNoise(HeadingFilter::Noise noise);
+  void setGps(int gpsPort, QLength xOffset, QLength yOffset);
+  void setGpsParameters(GpsCorrection::Parameters parameters);
+  void setPoseFromGps();
+  // Shares motor current between the drive sides and any mechanism groups
+  // added to getCurrentBudget, rebalanced every tick. Off until enabled.
+  void enableCurrentBudget(
+      CurrentBudget::GroupLimits driveLimits,
+      CurrentBudget::Parameters parameters = CurrentBudget::Parameters());
+  CurrentBudget& getCurrentBudget();
+  // Holds the drive sides at their slip limit while the drive wheels slip.
+  // forwardAxis is the IMU axis that points to the front of the robot. The
+  // limit is applied through the current budget, which is enabled with
+  // default drive limits if it isn't yet.
+  void enableTractionControl(
+      imuAxis forwardAxis,
+      SlipDetector::Parameters parameters = SlipDetector::Parameters());
+  bool isSlipping() const;
+  void startTracking(
+      ControlLoop::loopPeriod period = ControlLoop::period_10ms);
+  void stopTracking();
 
  protected:
-  std::vector<pros::Motor> leftDriveMotors;
-  std::vector<pros::Motor> rightDriveMotors;
+  void initializeDrive(std::vector<int> leftDriveMotorPorts,
+                       std::vector<int> rightDriveMotorPorts,
+                       double cartridgeRPM, double gearRatio,
+                       double wheelDiameter);
+  // update() runs these in order every tick. Drives with another wheel
+  // group, like HDrive, extend them instead of update().
+  virtual void applySensorReset();
+  virtual void sampleSensors();
+  virtual bool runMotion(const Pose& pose);
+  void sampleMotor(const pros::Motor& motor, MotorSample& sample);
+  void sampleRawPosition(const pros::Motor& motor, MotorSample& sample);
+  void updateOdometry();
+  QAngle fuseHeading(QLength left, QLength right, QTime timestamp);
+  void updateCurrentBudget();
+  static std::int32_t readAxis(controller_analog_e_t axis);
+  double slewDriverOutput(double target, double& output) const;
+  void driveSides(double left, double right);
+  QSpeed wheelSpeed(QAngularSpeed motorVelocity) const;
+  QSpeed getTopSpeed() const;
+  QLength getTrackWidth() const;
+  SideModel getSides() const;
+  MotorGroup leftDriveMotors;
+  MotorGroup rightDriveMotors;
   pros::Imu inertialSensor;
   pros::ADIEncoder leftEncoderTracker = pros::ADIEncoder(-1, -1, -1);
   pros::ADIEncoder rightEncoderTracker = pros::ADIEncoder(-1, -1, -1);
@@ -43,6 +190,7 @@ class Tank : public Chassis {
   pros::Rotation rightRotationTracker = pros::Rotation(-1);
   pros::Rotation centerRotationTracker = pros::Rotation(-1);
   int trackerType;
+  bool centerTrackerEnabled = false;
   int chassisType;
   double drivetrainCartridgeRPMS = 0;
   double drivetrainGearRatio = 0;
@@ -53,5 +201,37 @@ class Tank : public Chassis {
   double trackerGearRatio = 0;
   double trackerWheelDiameter = 0;
   double trackerWheelCircumference = 0;
+  SensorFrame sensorFrame;
+  Odometry odometry;
+  TimestampAligner timestampAligner;
+  HeadingFilter headingFilter;
+  bool headingFilterInitialized = false;
+  QLength lastFusionLeft;
+  QLength lastFusionRight;
+  QTime lastFusionTime;
+  std::unique_ptr<pros::Gps> gpsSensor;
+  GpsCorrection gpsCorrection;
+  PoseBuffer poseBuffer;
+  PoseBuffer poseResetBuffer;
+  std::uint32_t poseResetVersion = 0;
+  QLength trackerLeftDistance;
+  QLength trackerRightDistance;
+  std::atomic<bool> sensorResetRequested{false};
+  double maxVelocity = 0;
+  double maxVoltage = 12000;
+  const DriveCurve* driveCurve = &linearDriveCurve;
+  const DriveCurve* turnCurve = &linearDriveCurve;
+  double driverSlew = 0;
+  double leftDriverOutput = 0;
+  double rightDriverOutput = 0;
+  MotionCommands motionCommands;
+  CurrentBudget currentBudget;
+  std::size_t leftBudgetGroup = CurrentBudget::maxGroups;
+  std::size_t rightBudgetGroup = CurrentBudget::maxGroups;
+  std::atomic<bool> currentBudgetEnabled{false};
+  SlipDetector slipDetector;
+  imuAxis imuForwardAxis = imu_y;
+  std::atomic<bool> tractionControlEnabled{false};
+  std::unique_ptr<ControlLoop> controlLoop;
 };
 }  // namespace apollo
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <array>
+
+#include "apollo/chassis/sensorFrame.hpp"
+#include "apollo/units/QAngle.hpp"
+#include "apollo/units/QAngularSpeed.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+// Every smart port motor reports its encoder on its own schedule. This
+// resamples all drive motors to the oldest of their latest timestamps by
+// interpolating against each motor's previous reading, so odometry
+// integrates positions that were all true at the same instant.
+class TimestampAligner {
+ public:
+  struct AlignedSides {
+    QAngle left;
+    QAngle right;
+    QTime timestamp;
+  };
+  AlignedSides align(const SensorFrame& frame);
+  // The IMU gives no sample time, so its rotation is taken as read at the
+  // frame timestamp and carried back to the aligned time along the gyro
+  // rate. Clockwise positive, like SensorFrame::rotation.
+  static QAngle alignRotation(const SensorFrame& frame, QTime timestamp);
+  void reset();
+
+ protected:
+  using Samples = std::array<MotorSample, SensorFrame::maxSideMotors>;
+  static QAngle resample(const MotorSample& previous,
+                         const MotorSample& current, QTime timestamp);
+  static QAngle alignSide(const Samples& previous, const Samples& current,
+                          std::size_t count, QTime timestamp);
+  Samples previousLeft;
+  Samples previousRight;
+  bool initialized = false;
+};
+}  // namespace apollo
@@ -0,0 +1,52 @@
+#pragma once
+#include "apollo/chassis/holonomicKinematics.hpp"
+#include "apollo/chassis/odometry.hpp"
+#include "apollo/units/QLength.hpp"
+#include "pros/rotation.hpp"
+
+namespace apollo {
+// Tracker distances for Odometry::update, counted since the last reset.
+struct TrackerReadings {
+  QLength left;
+  QLength right;
+  QLength center;
+};
+
+// BasicChassis trackers policies. sample() runs once per tick with the
+// other sensor reads, measure() is given the robot frame travel the drive
+// wheels report through the kinematics.
+
+// Odometry from the drive motor encoders alone. Both parallel trackers see
+// the forward travel and the heading comes from the IMU.
+class MotorTrackers {
+ public:
+  void sample() {}
+  void reset() {}
+  Odometry::TrackerOffsets getOffsets() const { return {}; }
+  TrackerReadings measure(const HolonomicSpeeds& wheelTravel) const {
+    return {wheelTravel.forward * second, wheelTravel.forward * second,
+            wheelTravel.strafe * -1 * second};
+  }
+};
+
+// Two parallel and one perpendicular V5 rotation sensor tracking wheel,
+// which don't slip when a holonomic drive's rollers do. Negative ports
+// reverse the sensor; offsets are as in Odometry.
+class RotationTrackers {
+ public:
+  RotationTrackers(int leftPort, int rightPort, int centerPort,
+                   QLength wheelDiameter, Odometry::TrackerOffsets offsets);
+  void sample();
+  void reset();
+  Odometry::TrackerOffsets getOffsets() const;
+  TrackerReadings measure(const HolonomicSpeeds& wheelTravel) const;
+
+ protected:
+  pros::Rotation leftTracker;
+  pros::Rotation rightTracker;
+  pros::Rotation centerTracker;
+  QLength wheelCircumference;
+  Odometry::TrackerOffsets offsets;
+  TrackerReadings readings;
+};
+}  // namespace apollo
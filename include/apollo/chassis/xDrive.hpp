@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+#include "apollo/chassis/holonomicDrive.hpp"
+
+namespace apollo {
+// Four omni wheels mounted on the diagonals.
+class XDrive : public HolonomicDrive<FourWheelKinematics> {
+ public:
+  // trackRadius is the distance from the tracking center to each wheel.
+  XDrive(std::vector<int> frontLeftMotorPorts,
+         std::vector<int> frontRightMotorPorts,
+         std::vector<int> backLeftMotorPorts,
+         std::vector<int> backRightMotorPorts, int inertialSensorPort,
+         double cartridgeRPM, double gearRatio, double wheelDiameter,
+         QLength trackRadius);
+  // Applied from the next control tick, see BasicChassis::setKinematics.
+  void setTrackRadius(QLength trackRadius);
+};
+}  // namespace apollo
@@ -0,0 +1,61 @@
+#pragma once
+#include <cmath>
+#include <vector>
+
+#include "apollo/units/QAcceleration.hpp"
+#include "apollo/units/QLength.hpp"
+#include "apollo/units/QSpeed.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+// Voltage model of a drive side, in millivolts: kS overcomes static
+// friction, kV holds a speed in m/s and kA adds acceleration in m/s^2.
+struct FeedforwardGains {
+  double kS = 0;
+  double kV = 0;
+  double kA = 0;
+};
+
+class Feedforward {
+ public:
+  constexpr Feedforward() = default;
+  constexpr explicit Feedforward(const FeedforwardGains& gains)
+      : gains(gains) {}
+  constexpr const FeedforwardGains& getGains() const { return gains; }
+  double calculate(QSpeed velocity,
+                   QAcceleration acceleration = QAcceleration()) const {
+    double speed = velocity.convert(mps);
+    double sign = speed > 0 ? 1 : speed < 0 ? -1 : 0;
+    return gains.kS * sign + gains.kV * speed +
+           gains.kA * acceleration.convert(mps2);
+  }
+
+ protected:
+  FeedforwardGains gains;
+};
+
+// One control tick of a characterization run: the voltage applied and the
+// distance the side had travelled when it was sampled.
+struct CharacterizationSample {
+  QTime timestamp;
+  double voltage = 0;
+  QLength position;
+};
+
+// Least squares fit of voltage = kS sgn(v) + kV v + kA a. Velocity and
+// acceleration are differentiated from the positions of each run, so
+// every run must be passed as its own vector. Samples with the robot at
+// rest are left out, since static friction there is unknown. Returns
+// false when the runs don't pin down all three gains, for example
+// without a step test to excite kA.
+bool fitFeedforward(
+    const std::vector<std::vector<CharacterizationSample>>& runs,
+    FeedforwardGains& gains);
+
+// Characterization runs are logged as CSV (seconds, millivolts, meters) so
+// they can be copied off the SD card and fit on a host.
+bool writeCharacterizationLog(
+    const std::vector<CharacterizationSample>& samples, const char* path);
+bool readCharacterizationLog(const char* path,
+                             std::vector<CharacterizationSample>& samples);
+}  // namespace apollo
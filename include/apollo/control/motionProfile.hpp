@@ -0,0 +1,68 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+#include "apollo/units/QAcceleration.hpp"
+#include "apollo/units/QJerk.hpp"
+#include "apollo/units/QLength.hpp"
+#include "apollo/units/QSpeed.hpp"
+#include "apollo/units/QTime.hpp"
+
+namespace apollo {
+// A maxJerk of zero gives a trapezoidal profile, anything else a jerk
+// limited S-curve.
+struct ProfileConstraints {
+  QSpeed maxVelocity;
+  QAcceleration maxAcceleration;
+  QJerk maxJerk;
+};
+
+struct ProfileSetpoint {
+  QLength position;
+  QSpeed velocity;
+  QAcceleration acceleration;
+  QJerk jerk;
+};
+
+// Profile over a distance, from rest to rest unless start and end speeds
+// are given to blend with the moves around it. Speeds are signed like the
+// distance; an end speed the distance is too short to reach is replaced by
+// the nearest one that fits. The profile is solved once into at most seven
+// constant jerk segments, so sampling it is a short scan and a cubic,
+// independent of the move's length. Zero velocity or acceleration limits
+// leave the profile empty, which samples as a step to the distance.
+class MotionProfile {
+ public:
+  MotionProfile() = default;
+  MotionProfile(QLength distance, ProfileConstraints constraints,
+                QSpeed startVelocity = QSpeed(),
+                QSpeed endVelocity = QSpeed());
+  ProfileSetpoint sample(QTime time) const;
+  QTime getDuration() const;
+  QLength getDistance() const;
+  QSpeed getStartVelocity() const;
+  QSpeed getEndVelocity() const;
+  const ProfileConstraints& getConstraints() const;
+
+ protected:
+  struct Segment {
+    double startTime = 0;
+    double duration = 0;
+    double position = 0;
+    double velocity = 0;
+    double acceleration = 0;
+    double jerk = 0;
+  };
+  double changeDistance(double fromVelocity, double toVelocity) const;
+  void addVelocityChange(double fromVelocity, double toVelocity);
+  void addSegment(double duration, double acceleration, double jerk);
+  QLength distance;
+  ProfileConstraints constraints;
+  double direction = 1;
+  double startSpeed = 0;
+  double endSpeed = 0;
+  std::array<Segment, 7> segments;
+  std::size_t segmentCount = 0;
+  double duration = 0;
+};
+}  // namespace apollo
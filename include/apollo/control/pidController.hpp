@@ -0,0 +1,93 @@
+#pragma once
+#include "apollo/units/QTime.hpp"
+#include "apollo/units/RQuantity.hpp"
+
+namespace apollo {
+// Gains act on the SI values of the error and output quantities.
+// integralLimit caps the magnitude of the integral term's contribution
+// (0 disables the cap). derivativeFilter is the weight of the previous
+// derivative in a first order low pass, 0 leaves the D term unfiltered.
+struct PIDGains {
+  double kP = 0;
+  double kI = 0;
+  double kD = 0;
+  double integralLimit = 0;
+  double derivativeFilter = 0;
+};
+
+// PID over unit-typed quantities. For a fixed setpoint the derivative is
+// taken on the measurement rather than the error, so setpoint steps don't
+// kick the output. A moving setpoint, like a motion profile, passes its
+// rate and the measured rate instead: the derivative is then the tracking
+// error's rate, which doesn't fight the feedforward driving the profile.
+// Everything is inline on plain doubles, so it costs the same as a hand
+// written loop.
+template <typename ErrorQuantity, typename OutputQuantity = Number>
+class PIDController {
+ public:
+  using RateQuantity = decltype(ErrorQuantity() / QTime());
+  constexpr PIDController() = default;
+  constexpr explicit PIDController(const PIDGains& gains) : gains(gains) {}
+  constexpr void setGains(const PIDGains& gains) { this->gains = gains; }
+  constexpr const PIDGains& getGains() const { return gains; }
+
+  constexpr OutputQuantity step(ErrorQuantity setpoint,
+                                ErrorQuantity measurement, QTime deltaTime) {
+    double dt = deltaTime.getValue();
+    bool hasDerivative = !firstStep && dt > 0;
+    double rawDerivative =
+        hasDerivative ? -(measurement.getValue() - lastMeasurement) / dt : 0;
+    lastMeasurement = measurement.getValue();
+    return output(setpoint.getValue() - measurement.getValue(), rawDerivative,
+                  hasDerivative, dt);
+  }
+  constexpr OutputQuantity step(ErrorQuantity setpoint,
+                                ErrorQuantity measurement,
+                                RateQuantity setpointRate,
+                                RateQuantity measuredRate, QTime deltaTime) {
+    lastMeasurement = measurement.getValue();
+    return output(setpoint.getValue() - measurement.getValue(),
+                  setpointRate.getValue() - measuredRate.getValue(), true,
+                  deltaTime.getValue());
+  }
+
+  constexpr void reset() {
+    integral = 0;
+    lastMeasurement = 0;
+    lastDerivative = 0;
+    firstStep = true;
+  }
+
+ private:
+  constexpr OutputQuantity output(double error, double rawDerivative,
+                                  bool hasDerivative, double dt) {
+    double derivative = 0;
+    if (hasDerivative) {
+      derivative = firstStep ? rawDerivative
+                             : gains.derivativeFilter * lastDerivative +
+                                   (1 - gains.derivativeFilter) * rawDerivative;
+    }
+    integral += error * dt;
+    double integralTerm = gains.kI * integral;
+    if (gains.integralLimit > 0 && gains.kI != 0) {
+      if (integralTerm > gains.integralLimit) {
+        integralTerm = gains.integralLimit;
+        integral = integralTerm / gains.kI;
+      } else if (integralTerm < -gains.integralLimit) {
+        integralTerm = -gains.integralLimit;
+        integral = integralTerm / gains.kI;
+      }
+    }
+    lastDerivative = derivative;
+    firstStep = false;
+    return OutputQuantity(gains.kP * error + integralTerm +
+                          gains.kD * derivative);
+  }
+
+  PIDGains gains;
+  double integral = 0;
+  double lastMeasurement = 0;
+  double lastDerivative = 0;
+  bool firstStep = true;
+};
+}  // namespace apollo
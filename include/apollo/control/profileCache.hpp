@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <cstddef>
+
+#include "apollo/control/motionProfile.hpp"
+
+namespace apollo {
+// Keeps the last few solved profiles so repeated moves skip the solve.
+// Entries match on the exact distance, constraints and start and end
+// speeds; the oldest entry is replaced once the cache is full. A returned
+// profile is only valid until the next get.
+template <std::size_t Capacity = 8>
+class ProfileCache {
+  static_assert(Capacity >= 1, "ProfileCache needs at least one entry");
+
+ public:
+  const MotionProfile& get(QLength distance, ProfileConstraints constraints,
+                           QSpeed startVelocity = QSpeed(),
+                           QSpeed endVelocity = QSpeed()) {
+    for (std::size_t i = 0; i < count; i++) {
+      if (matches(entries[i], distance, constraints, startVelocity,
+                  endVelocity)) {
+        return entries[i];
+      }
+    }
+    MotionProfile& entry = entries[next];
+    entry = MotionProfile(distance, constraints, startVelocity, endVelocity);
+    next = (next + 1) % Capacity;
+    if (count < Capacity) {
+      count++;
+    }
+    return entry;
+  }
+  void clear() {
+    count = 0;
+    next = 0;
+  }
+  std::size_t size() const { return count; }
+
+ protected:
+  static bool matches(const MotionProfile& profile, QLength distance,
+                      const ProfileConstraints& constraints,
+                      QSpeed startVelocity, QSpeed endVelocity) {
+    const ProfileConstraints& cached = profile.getConstraints();
+    return profile.getDistance() == distance &&
+           profile.getStartVelocity() == startVelocity &&
+           profile.getEndVelocity() == endVelocity &&
+           cached.maxVelocity == constraints.maxVelocity &&
+           cached.maxAcceleration == constraints.maxAcceleration &&
+           cached.maxJerk == constraints.maxJerk;
+  }
+  std::array<MotionProfile, Capacity> entries;
+  std::size_t count = 0;
+  std::size_t next = 0;
+};
+}  // namespace apollo
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "apollo/chassis/pose.hpp"
+#include "apollo/units/QLength.hpp"
+
+namespace apollo {
+struct Waypoint {
+  QLength x;
+  QLength y;
+};
+
+// Pure pursuit over a polyline of waypoints. The closest point and the
+// lookahead intersection are searched from where they were last tick and
+// only one lookahead distance along the path past the closest point, so a
+// tick costs the same on a path of ten points or ten thousand. Both only
+// ever move forward along the path.
+class PurePursuit {
+ public:
+  PurePursuit(std::vector<Waypoint> path, QLength lookahead);
+  void reset();
+  // Advances the search from the pose and returns the curvature, in 1/m
+  // and positive to the left, of the arc to the lookahead point.
+  double update(const Pose& pose);
+  Waypoint getLookaheadPoint() const;
+  std::size_t getClosestIndex() const;
+  QLength getTravelled() const;
+  QLength getRemaining() const;
+  QLength getLength() const;
+  bool isAtEnd() const;
+
+ protected:
+  void updateClosest(double x, double y);
+  void updateLookahead(double x, double y);
+  void setLookahead(std::size_t segment, double fraction);
+  std::vector<double> pathX;
+  std::vector<double> pathY;
+  // Path length from the first waypoint to each waypoint.
+  std::vector<double> pathDistance;
+  double lookahead;
+  std::size_t closestSegment = 0;
+  double closestFraction = 0;
+  std::size_t lookaheadSegment = 0;
+  double lookaheadFraction = 0;
+  double lookaheadX = 0;
+  double lookaheadY = 0;
+};
+}  // namespace apollo
@@ -0,0 +1,37 @@
+#pragma once
+#include "apollo/chassis/pose.hpp"
+#include "apollo/trajectory/trajectory.hpp"
+#include "apollo/units/QAngularSpeed.hpp"
+#include "apollo/units/QFrequency.hpp"
+#include "apollo/units/QSpeed.hpp"
+
+namespace apollo {
+struct ChassisSpeeds {
+  QSpeed linear;
+  QAngularSpeed angular;
+};
+
+struct WheelVelocities {
+  QSpeed left;
+  QSpeed right;
+};
+
+// RAMSETE trajectory tracking for a differential drive. b (rad^2/m^2) sets
+// how hard position error is corrected and zeta (0 to 1) damps it; 2 and
+// 0.7 suit most drivetrains. Unlike PID on distance and heading it also
+// steers out cross-track error.
+class RamseteController {
+ public:
+  explicit RamseteController(double b = 2, double zeta = 0.7);
+  void setGains(double b, double zeta);
+  // Chassis velocities that bring the pose onto the reference.
+  ChassisSpeeds step(const Pose& pose,
+                     const TrajectoryPoint& reference) const;
+  WheelVelocities step(const Pose& pose, const TrajectoryPoint& reference,
+                       QLength trackWidth) const;
+
+ protected:
+  double b;
+  double zeta;
+};
+}  // namespace apollo
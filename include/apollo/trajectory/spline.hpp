@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "apollo/units/QAngle.hpp"
+#include "apollo/units/QLength.hpp"
+
+namespace apollo {
+// A point the path passes through with the heading it passes at. The
+// tangent's length is tangentScale times the distance to the neighbouring
+// point; larger values hold the heading for longer before curving.
+struct SplinePoint {
+  QLength x;
+  QLength y;
+  QAngle heading;
+  double tangentScale = 1;
+};
+
+// Quintic Hermite segment between two points with zero second derivative
+// at both ends, so curvature is continuous across segments. Positions are
+// in meters and the parameter runs from 0 to 1.
+class QuinticSpline {
+ public:
+  QuinticSpline(const SplinePoint& start, const SplinePoint& end);
+  void position(double t, double& x, double& y) const;
+  void derivative(double t, double& x, double& y) const;
+  void secondDerivative(double t, double& x, double& y) const;
+  // Signed curvature in 1/m, positive to the left.
+  double curvature(double t) const;
+
+ protected:
+  std::array<double, 6> xCoefficients;
+  std::array<double, 6> yCoefficients;
+};
+
+class SplinePath {
+ public:
+  explicit SplinePath(const std::vector<SplinePoint>& points);
+  const QuinticSpline& operator[](std::size_t index) const;
+  std::size_t size() const;
+
+ protected:
+  std::vector<QuinticSpline> splines;
+};
+}  // namespace apollo
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "apollo/chassis/pose.hpp"
+#include "apollo/trajectory/spline.hpp"
+#include "apollo/units/QAcceleration.hpp"
+#include "apollo/units/QAngularSpeed.hpp"
+#include "apollo/units/QSpeed.hpp"
+
+namespace apollo {
+// pose.timestamp is the time from the start of the trajectory. Wheel
+// velocities are for a differential drive of the constraints' track width.
+struct TrajectoryPoint {
+  Pose pose;
+  QLength distance;
+  QSpeed velocity;
+  QAcceleration acceleration;
+  QAngularSpeed angularVelocity;
+  double curvature = 0;
+  QSpeed leftVelocity;
+  QSpeed rightVelocity;
+};
+
+// Linear interpolation between two neighbouring points at a time between
+// their timestamps.
+TrajectoryPoint interpolate(const TrajectoryPoint& start,
+                            const TrajectoryPoint& end, QTime time);
+
+// maxVelocity is the top wheel speed, see Tank::getTrajectoryConstraints.
+struct TrajectoryConstraints {
+  QSpeed maxVelocity;
+  QAcceleration maxAcceleration;
+  QLength trackWidth;
+};
+
+// Anything a trajectory can be sampled from by time, in memory or
+// streamed from a file.
+class TrajectorySource {
+ public:
+  virtual ~TrajectorySource() = default;
+  virtual TrajectoryPoint sample(QTime time) const = 0;
+  virtual QTime getDuration() const = 0;
+  virtual QLength getLength() const = 0;
+};
+
+// Dense, time-parameterized trajectory. Points are sorted by timestamp,
+// so sampling binary searches and interpolates between neighbours.
+class Trajectory : public TrajectorySource {
+ public:
+  Trajectory() = default;
+  explicit Trajectory(std::vector<TrajectoryPoint> points);
+  TrajectoryPoint sample(QTime time) const override;
+  QTime getDuration() const override;
+  QLength getLength() const override;
+  const TrajectoryPoint& operator[](std::size_t index) const;
+  std::size_t size() const;
+  bool empty() const;
+
+ protected:
+  std::vector<TrajectoryPoint> points;
+};
+
+// Samples a spline path every spacing of arc length and plans the fastest
+// rest to rest velocity along it. Each point is first capped so the outer
+// wheel stays under maxVelocity through its curvature, then a forward and
+// a backward pass limit acceleration and deceleration. Nothing here
+// touches the brain, so trajectories can be generated and timed on a host.
+class TrajectoryGenerator {
+ public:
+  explicit TrajectoryGenerator(TrajectoryConstraints constraints,
+                               QLength spacing = 1 * centimeter);
+  Trajectory generate(const SplinePath& path) const;
+
+ protected:
+  TrajectoryConstraints constraints;
+  QLength spacing;
+};
+}  // namespace apollo
@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "apollo/trajectory/trajectory.hpp"
+#include "pros/rtos.hpp"
+
+namespace apollo {
+// Trajectory files hold little endian float32 data:
+//   header      "APTR", version, field count, point count, chunk size,
+//               duration, length and track width
+//   chunk index start time of every chunk
+//   chunks      chunkSize points each, stored field by field
+// Consecutive chunks share their boundary point, so any time between two
+// chunk start times can be interpolated inside a single chunk.
+namespace trajectoryFile {
+constexpr std::uint32_t magic = 0x52545041;  // "APTR"
+constexpr std::uint16_t version = 1;
+// time, x, y, theta, distance, velocity, acceleration, curvature
+constexpr std::uint16_t fieldCount = 8;
+constexpr std::size_t headerSize = 28;
+// Largest chunk a reader accepts, 128 KiB of points per buffer.
+constexpr std::uint32_t maxChunkSize = 4096;
+}  // namespace trajectoryFile
+
+class TrajectoryWriter {
+ public:
+  // chunkSize is clamped to 2..trajectoryFile::maxChunkSize.
+  explicit TrajectoryWriter(std::uint32_t chunkSize = 128);
+  // Returns false if the file can't be written.
+  bool write(const Trajectory& trajectory, QLength trackWidth,
+             const char* path) const;
+
+ protected:
+  std::uint32_t chunkSize;
+};
+
+// Streams a trajectory file, keeping two chunks in memory: the one being
+// sampled and the next, which a lower priority task reads ahead from the
+// SD card. Sampling forward in time then only swaps the two; a seek, or a
+// read ahead that hasn't finished, reads the chunk on the sampling task
+// instead. Not safe to sample from several tasks at once.
+class TrajectoryReader : public TrajectorySource {
+ public:
+  TrajectoryReader() = default;
+  TrajectoryReader(const TrajectoryReader&) = delete;
+  TrajectoryReader& operator=(const TrajectoryReader&) = delete;
+  ~TrajectoryReader() override;
+  // Returns false if the file is missing, truncated or of another version,
+  // or if its header doesn't match its size. Nothing is allocated for a
+  // header that fails the checks.
+  bool open(const char* path,
+            std::uint32_t prefetchPriority = TASK_PRIORITY_DEFAULT);
+  void close();
+  bool isOpen() const;
+  TrajectoryPoint sample(QTime time) const override;
+  QTime getDuration() const override;
+  QLength getLength() const override;
+  std::size_t size() const;
+  // Chunks read on the sampling task rather than ahead of it, the first
+  // chunk included. Stays at one while the read ahead keeps up.
+  std::uint32_t getBlockingReads() const;
+
+ protected:
+  struct ChunkBuffer {
+    std::vector<float> values;
+    std::vector<std::uint8_t> bytes;
+    std::size_t index = SIZE_MAX;
+    std::size_t points = 0;
+  };
+  // The back buffer belongs to the prefetch task while it is loading and
+  // to the sampling task otherwise.
+  enum bufferState { buffer_idle, buffer_loading, buffer_ready };
+  bool loadChunk(std::size_t index, ChunkBuffer& buffer) const;
+  bool useChunk(std::size_t index) const;
+  void prefetch(std::size_t index) const;
+  void runPrefetch();
+  void stopPrefetch();
+  TrajectoryPoint point(std::size_t index) const;
+  std::FILE* file = nullptr;
+  std::uint32_t pointCount = 0;
+  std::uint32_t chunkSize = 0;
+  float duration = 0;
+  float length = 0;
+  float halfTrack = 0;
+  std::vector<float> chunkStartTimes;
+  mutable ChunkBuffer buffers[2];
+  mutable ChunkBuffer* front = &buffers[0];
+  mutable ChunkBuffer* back = &buffers[1];
+  mutable std::atomic<int> backState{buffer_idle};
+  mutable std::uint32_t blockingReads = 0;
+  mutable pros::Mutex fileMutex;
+  std::unique_ptr<pros::Task> prefetchTask;
+  std::atomic<bool> prefetchRunning{false};
+  std::atomic<bool> prefetchExited{true};
+};
+}  // namespace apollo
@@ -16,6 +16,7 @@ QUANTITY_TYPE(0, 0, 1, 0, QTime)
 
 constexpr QTime second(1.0);  // SI base unit
 constexpr QTime millisecond = second / 1000;
+constexpr QTime microsecond = millisecond / 1000;
 constexpr QTime minute = 60 * second;
 constexpr QTime hour = 60 * minute;
 constexpr QTime day = 24 * hour;
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+namespace apollo::util {
+class Clock {
+ public:
+  virtual ~Clock() = default;
+  virtual std::uint32_t millis() const = 0;
+  virtual std::uint64_t micros() const = 0;
+  virtual void delayUntil(std::uint32_t* previousTime,
+                          std::uint32_t delta) = 0;
+};
+
+// Wraps pros::millis, pros::micros and pros::Task::delay_until.
+class ProsClock : public Clock {
+ public:
+  std::uint32_t millis() const override;
+  std::uint64_t micros() const override;
+  void delayUntil(std::uint32_t* previousTime, std::uint32_t delta) override;
+};
+
+// Host stand-in for ProsClock. Time only moves when advance() is called or
+// when delayUntil() sleeps, which makes control loop timing deterministic off
+// the brain.
+class ManualClock : public Clock {
+ public:
+  std::uint32_t millis() const override {
+    return static_cast<std::uint32_t>(currentTime / 1000);
+  }
+  std::uint64_t micros() const override { return currentTime; }
+  void delayUntil(std::uint32_t* previousTime, std::uint32_t delta) override {
+    std::uint64_t wakeTime =
+        static_cast<std::uint64_t>(*previousTime + delta) * 1000;
+    if (wakeTime > currentTime) {
+      currentTime = wakeTime;
+    }
+    *previousTime += delta;
+  }
+  void advance(std::uint64_t microseconds) { currentTime += microseconds; }
+
+ private:
+  std::uint64_t currentTime = 0;
+};
+}  // namespace apollo::util
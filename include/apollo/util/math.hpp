@@ -7,6 +7,10 @@ constexpr double degreesToRadians(double degrees) {
 constexpr double radiansToDegrees(double radians) {
   return (180 / M_PI) * radians;
 }
+// Wraps an angle to [-pi, pi), the shortest way round to it.
+inline double wrapRadians(double radians) {
+  return radians - 2 * M_PI * ::floor((radians + M_PI) / (2 * M_PI));
+}
 constexpr double slew(double targetValue, double currentValue,
                       double maxChange) {
   double change = targetValue - currentValue;
@@ -19,6 +23,25 @@ constexpr double slew(double targetValue, double currentValue,
   }
   return currentValue + change;
 }
+// e^x that can run at compile time, for building lookup tables. The
+// argument is halved until the series converges quickly, then squared back.
+constexpr double exponential(double x) {
+  int halvings = 0;
+  while (x > 0.5 || x < -0.5) {
+    x /= 2;
+    halvings++;
+  }
+  double term = 1;
+  double sum = 1;
+  for (int i = 1; i < 20; i++) {
+    term *= x / i;
+    sum += term;
+  }
+  for (; halvings > 0; halvings--) {
+    sum *= sum;
+  }
+  return sum;
+}
 constexpr double clipValues(double inputValue, double maxiumValue,
                             double minimumValue) {
   if (inputValue > maxiumValue) {
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace apollo::util {
+// Single-writer, multi-reader snapshot buffer. The writer never waits: it
+// fills the slot after the most recently published one and then publishes
+// it. Readers copy the latest slot and retry only if the writer lapped every
+// slot mid-copy, so no task can be blocked behind a lower priority one.
+template <typename T, std::size_t Slots = 3>
+class TripleBuffer {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "TripleBuffer values must be trivially copyable");
+  static_assert(Slots >= 2, "TripleBuffer needs at least two slots");
+
+ public:
+  TripleBuffer() = default;
+  explicit TripleBuffer(const T& initialValue) {
+    for (auto& slot : slots) {
+      slot.value = initialValue;
+    }
+  }
+
+  void publish(const T& value) {
+    std::uint32_t index = (latest.load(std::memory_order_relaxed) + 1) % Slots;
+    Slot& slot = slots[index];
+    slot.sequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.value = value;
+    slot.sequence.fetch_add(1, std::memory_order_release);
+    latest.store(index, std::memory_order_release);
+    version.fetch_add(1, std::memory_order_release);
+  }
+
+  // A reader delayed after loading the index can find its slot refilled
+  // with a newer value that isn't published yet. Returning it would let the
+  // next read go backwards, so the slot also has to still be the latest.
+  T read() const {
+    while (true) {
+      std::uint32_t index = latest.load(std::memory_order_acquire);
+      const Slot& slot = slots[index];
+      std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+      if (before & 1) {
+        continue;
+      }
+      T value = slot.value;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == before &&
+          latest.load(std::memory_order_relaxed) == index) {
+        return value;
+      }
+    }
+  }
+
+  // Incremented on every publish, lets readers skip unchanged snapshots.
+  std::uint32_t getVersion() const {
+    return version.load(std::memory_order_acquire);
+  }
+
+ private:
+  struct Slot {
+    std::atomic<std::uint32_t> sequence{0};
+    T value{};
+  };
+  Slot slots[Slots];
+  std::atomic<std::uint32_t> latest{0};
+  std::atomic<std::uint32_t> version{0};
+};
+}  // namespace apollo::util
@@ -0,0 +1,22 @@
+#include "apollo/chassis/asteriskDrive.hpp"
+
+namespace apollo {
+AsteriskDrive::AsteriskDrive(std::vector<int> frontLeftMotorPorts,
+                             std::vector<int> frontRightMotorPorts,
+                             std::vector<int> backLeftMotorPorts,
+                             std::vector<int> backRightMotorPorts,
+                             std::vector<int> middleLeftMotorPorts,
+                             std::vector<int> middleRightMotorPorts,
+                             int inertialSensorPort, double cartridgeRPM,
+                             double gearRatio, double wheelDiameter,
+                             QLength cornerRadius, QLength middleRadius)
+    : HolonomicDrive({frontLeftMotorPorts, frontRightMotorPorts,
+                      backLeftMotorPorts, backRightMotorPorts,
+                      middleLeftMotorPorts, middleRightMotorPorts},
+                     inertialSensorPort, cartridgeRPM, gearRatio,
+                     wheelDiameter, {cornerRadius, middleRadius}) {}
+void AsteriskDrive::setDimensions(QLength cornerRadius,
+                                  QLength middleRadius) {
+  setKinematics({cornerRadius, middleRadius});
+}
+}  // namespace apollo
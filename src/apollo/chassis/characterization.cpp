@@ -0,0 +1,127 @@
+#include "apollo/chassis/characterization.hpp"
+
+#include <cmath>
+#include <string>
+
+namespace apollo {
+CharacterizationMotion::CharacterizationMotion(testType type, double voltage,
+                                               QTime duration,
+                                               QLength maxDistance)
+    : type(type), voltage(voltage), maxDistance(maxDistance) {
+  exitConditions = ExitConditions();
+  exitConditions.timeout = duration;
+  // One sample per tick at the fastest control loop period, so the
+  // control task never allocates mid-run.
+  samples.reserve(duration.convert(millisecond) / 5 + 1);
+}
+void CharacterizationMotion::start(const MotionContext& context) {
+  Motion::start(context);
+  startLeft = context.leftDistance;
+  startRight = context.rightDistance;
+  samples.clear();
+}
+DriveOutput CharacterizationMotion::step(const MotionContext& context) {
+  QTime elapsed = context.timestamp - startTime;
+  QLength travelled = ((context.leftDistance - startLeft) +
+                       (context.rightDistance - startRight)) /
+                      2;
+  state->progress = travelled.convert(meter);
+  double output = type == test_step
+                      ? voltage
+                      : voltage * elapsed.convert(second);
+  output = std::fmax(std::fmin(output, 12000.0), -12000.0);
+  if (samples.size() < samples.capacity()) {
+    samples.push_back({elapsed, output, travelled});
+  }
+  if (abs(travelled) >= maxDistance) {
+    settle(exit_completed, context.timestamp);
+  }
+  if (updateSettled(INFINITY, context)) {
+    return DriveOutput();
+  }
+  return {output, output};
+}
+const std::vector<CharacterizationSample>&
+CharacterizationMotion::getSamples() const {
+  return samples;
+}
+
+namespace {
+constexpr QSpeed restingSpeed = 0.01 * mps;
+constexpr const char* runNames[] = {"quasistatic_forward",
+                                    "quasistatic_backward", "step_forward",
+                                    "step_backward"};
+}  // namespace
+
+CharacterizationSequence::CharacterizationSequence(
+    const CharacterizationSettings& settings)
+    : restTime(settings.restTime) {
+  exitConditions = ExitConditions();
+  using test = CharacterizationMotion;
+  runs[quasistatic_forward] = std::make_unique<test>(
+      test::test_quasistatic, settings.rampRate, settings.duration,
+      settings.maxDistance);
+  runs[quasistatic_backward] = std::make_unique<test>(
+      test::test_quasistatic, settings.rampRate * -1, settings.duration,
+      settings.maxDistance);
+  runs[step_forward] =
+      std::make_unique<test>(test::test_step, settings.stepVoltage,
+                             settings.duration, settings.maxDistance);
+  runs[step_backward] =
+      std::make_unique<test>(test::test_step, settings.stepVoltage * -1,
+                             settings.duration, settings.maxDistance);
+}
+void CharacterizationSequence::start(const MotionContext& context) {
+  Motion::start(context);
+  current = 0;
+  resting = true;
+  stillSince = context.timestamp;
+}
+// Between runs the drive coasts until both sides have been still for
+// restTime, so every run starts from rest.
+DriveOutput CharacterizationSequence::step(const MotionContext& context) {
+  if (resting) {
+    if (abs(context.leftVelocity) >= restingSpeed ||
+        abs(context.rightVelocity) >= restingSpeed) {
+      stillSince = context.timestamp;
+    }
+    if (context.timestamp - stillSince < restTime) {
+      return DriveOutput();
+    }
+    if (current == runCount) {
+      settle(exit_completed, context.timestamp);
+      return DriveOutput();
+    }
+    runs[current]->start(context);
+    resting = false;
+  }
+  state->progress = current;
+  DriveOutput output = runs[current]->step(context);
+  if (runs[current]->getState()->settled) {
+    current++;
+    resting = true;
+    stillSince = context.timestamp;
+  }
+  return output;
+}
+const std::vector<CharacterizationSample>&
+CharacterizationSequence::getSamples(runType index) const {
+  return runs[index]->getSamples();
+}
+bool CharacterizationSequence::writeLogs(const char* prefix) const {
+  bool written = true;
+  for (std::size_t i = 0; i < runCount; i++) {
+    std::string path = std::string(prefix) + "_" + runNames[i] + ".csv";
+    written = writeCharacterizationLog(runs[i]->getSamples(), path.c_str()) &&
+              written;
+  }
+  return written;
+}
+bool CharacterizationSequence::fit(FeedforwardGains& gains) const {
+  std::vector<std::vector<CharacterizationSample>> samples;
+  for (const std::unique_ptr<CharacterizationMotion>& test : runs) {
+    samples.push_back(test->getSamples());
+  }
+  return fitFeedforward(samples, gains);
+}
+}  // namespace apollo
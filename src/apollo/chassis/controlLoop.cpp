@@ -0,0 +1,96 @@
+#include "apollo/chassis/controlLoop.hpp"
+
+namespace apollo {
+namespace {
+util::ProsClock defaultClock;
+}
+
+ControlLoop::ControlLoop(Chassis& chassis, loopPeriod period)
+    : ControlLoop(chassis, period, defaultClock) {}
+ControlLoop::ControlLoop(Chassis& chassis, loopPeriod period,
+                         util::Clock& clock)
+    : chassis(chassis), clock(clock), period(period) {}
+ControlLoop::~ControlLoop() { stop(); }
+
+void ControlLoop::start(std::uint32_t priority) {
+  if (running.exchange(true)) {
+    return;
+  }
+  firstTick = true;
+  taskExited = false;
+  task = std::make_unique<pros::Task>(
+      [this] {
+        while (running) {
+          step();
+        }
+        // Last access to the loop; stop() may destroy it right after this.
+        taskExited = true;
+      },
+      priority, TASK_STACK_DEPTH_DEFAULT, "Apollo Control Loop");
+}
+void ControlLoop::stop() {
+  running = false;
+  if (!task) {
+    return;
+  }
+  // The task handle may already be freed once the task function returns, so
+  // wait on the flag it sets instead of querying its state. A loop stopping
+  // itself from inside chassis.update() can't wait on its own exit.
+  if (static_cast<pros::task_t>(pros::Task::current()) !=
+      static_cast<pros::task_t>(*task)) {
+    while (!taskExited) {
+      pros::delay(1);
+    }
+  }
+  task.reset();
+}
+
+void ControlLoop::step() {
+  std::uint64_t tickStart = clock.micros();
+  if (statisticsResetRequested.exchange(false)) {
+    statistics = Statistics();
+    firstTick = true;
+  }
+  if (firstTick) {
+    wakeTime = clock.millis();
+    firstTick = false;
+  } else {
+    std::uint64_t nominal = static_cast<std::uint64_t>(period) * 1000;
+    std::uint64_t measured = tickStart - lastTickStart;
+    std::uint64_t jitter =
+        measured > nominal ? measured - nominal : nominal - measured;
+    statistics.lastPeriod = measured;
+    if (jitter > statistics.maxJitter) {
+      statistics.maxJitter = jitter;
+    }
+    statistics.meanJitter +=
+        (jitter - statistics.meanJitter) / statistics.ticks;
+  }
+  lastTickStart = tickStart;
+
+  chassis.update();
+
+  std::uint64_t executionTime = clock.micros() - tickStart;
+  statistics.lastExecutionTime = executionTime;
+  if (executionTime > statistics.maxExecutionTime) {
+    statistics.maxExecutionTime = executionTime;
+  }
+  statistics.ticks++;
+  // Resynchronise after an overrun rather than letting delay_until burst
+  // through the missed ticks back to back.
+  std::uint32_t now = clock.millis();
+  if (now - wakeTime >= period) {
+    statistics.overruns++;
+    wakeTime = now;
+  }
+  publishedStatistics.publish(statistics);
+  clock.delayUntil(&wakeTime, period);
+}
+
+void ControlLoop::resetStatistics() { statisticsResetRequested = true; }
+bool ControlLoop::isRunning() const { return running; }
+std::uint32_t ControlLoop::getPeriod() const { return period; }
+ControlLoop::Statistics ControlLoop::getStatistics() const {
+  return publishedStatistics.read();
+}
+}  // namespace apollo
@@ -0,0 +1,145 @@
+#include "apollo/chassis/currentBudget.hpp"
+
+#include <algorithm>
+
+namespace apollo {
+CurrentBudget::CurrentBudget() : CurrentBudget(Parameters()) {}
+CurrentBudget::CurrentBudget(Parameters parameters)
+    : parameters(parameters) {}
+void CurrentBudget::setParameters(Parameters parameters) {
+  mutex.take(TIMEOUT_MAX);
+  this->parameters = parameters;
+  mutex.give();
+}
+
+std::size_t CurrentBudget::addGroup(MotorGroup& motors, GroupLimits limits) {
+  mutex.take(TIMEOUT_MAX);
+  std::size_t index = count;
+  if (count < maxGroups) {
+    groups[count] = {&motors, limits, limits.maximum, false, 0, false};
+    order[count] = count;
+    count++;
+    sortByPriority();
+  }
+  mutex.give();
+  return index;
+}
+void CurrentBudget::setLimits(std::size_t group, GroupLimits limits) {
+  mutex.take(TIMEOUT_MAX);
+  if (group < count) {
+    groups[group].limits = limits;
+    sortByPriority();
+  }
+  mutex.give();
+}
+void CurrentBudget::setSlipping(std::size_t group, bool slipping) {
+  if (group < count) {
+    groups[group].slipping = slipping;
+  }
+}
+void CurrentBudget::setCurrentDraw(std::size_t group, std::int32_t draw) {
+  if (group < count) {
+    groups[group].sampledDraw = draw;
+    groups[group].drawSampled = true;
+  }
+}
+// Insertion sort, stable so equal priorities keep the order they were
+// added in.
+void CurrentBudget::sortByPriority() {
+  for (std::size_t i = 1; i < count; i++) {
+    std::size_t index = order[i];
+    std::size_t j = i;
+    for (; j > 0 && groups[order[j - 1]].limits.priority <
+                        groups[index].limits.priority;
+         j--) {
+      order[j] = order[j - 1];
+    }
+    order[j] = index;
+  }
+}
+
+void CurrentBudget::update() {
+  if (!mutex.take(0)) {
+    return;
+  }
+  std::int32_t remaining = parameters.totalLimit;
+  std::array<std::int32_t, maxGroups> demand;
+  std::array<std::int32_t, maxGroups> ceiling;
+  std::array<std::int32_t, maxGroups> minimum;
+  for (std::size_t i = 0; i < count; i++) {
+    Group& group = groups[i];
+    std::int32_t motorCount = group.motors->size();
+    ceiling[i] = group.slipping ? std::min(group.limits.maximum,
+                                           group.limits.slipLimit)
+                                : group.limits.maximum;
+    minimum[i] = std::min(group.limits.minimum, ceiling[i]);
+    std::int32_t draw = group.drawSampled ? group.sampledDraw
+                                          : group.motors->getCurrentDraw();
+    group.drawSampled = false;
+    std::int32_t perMotor = motorCount > 0 ? draw / motorCount : 0;
+    demand[i] =
+        std::clamp(perMotor + parameters.headroom, minimum[i], ceiling[i]);
+    group.limit = minimum[i];
+    remaining -= minimum[i] * motorCount;
+  }
+  for (const std::array<std::int32_t, maxGroups>* targets :
+       {&demand, &ceiling}) {
+    std::size_t first = 0;
+    while (first < count) {
+      std::size_t last = first + 1;
+      while (last < count && groups[order[last]].limits.priority ==
+                                 groups[order[first]].limits.priority) {
+        last++;
+      }
+      remaining = share(first, last, *targets, remaining);
+      first = last;
+    }
+  }
+  for (std::size_t i = 0; i < count; i++) {
+    Group& group = groups[i];
+    if (parameters.step > 1) {
+      group.limit = std::max(group.limit - group.limit % parameters.step,
+                             minimum[i]);
+    }
+    group.motors->setCurrentLimit(group.limit);
+  }
+  mutex.give();
+}
+// Splits what is left evenly per motor between the groups at positions
+// first to last of the priority order, raising each towards its target.
+// What a group can't use goes to the others, so each round settles at
+// least one group and the loop ends within one round per group.
+std::int32_t CurrentBudget::share(
+    std::size_t first, std::size_t last,
+    const std::array<std::int32_t, maxGroups>& targets,
+    std::int32_t remaining) {
+  for (std::size_t round = first; round < last && remaining > 0; round++) {
+    std::int32_t motorCount = 0;
+    for (std::size_t i = first; i < last; i++) {
+      const Group& group = groups[order[i]];
+      if (targets[order[i]] > group.limit) {
+        motorCount += group.motors->size();
+      }
+    }
+    if (motorCount == 0 || remaining / motorCount == 0) {
+      break;
+    }
+    std::int32_t perMotor = remaining / motorCount;
+    for (std::size_t i = first; i < last; i++) {
+      Group& group = groups[order[i]];
+      std::int32_t raise =
+          std::min(targets[order[i]] - group.limit, perMotor);
+      if (raise > 0) {
+        group.limit += raise;
+        remaining -= raise * static_cast<std::int32_t>(group.motors->size());
+      }
+    }
+  }
+  return remaining;
+}
+
+std::int32_t CurrentBudget::getLimit(std::size_t group) const {
+  return group < count ? groups[group].limit : 0;
+}
+std::size_t CurrentBudget::size() const { return count; }
+}  // namespace apollo
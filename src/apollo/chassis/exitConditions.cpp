@@ -0,0 +1,83 @@
+#include "apollo/chassis/exitConditions.hpp"
+
+#include <cmath>
+
+namespace apollo {
+bool ExitConditionMonitor::Window::update(bool condition, QTime timestamp,
+                                          QTime duration) {
+  if (!condition || duration <= QTime()) {
+    inside = false;
+    return false;
+  }
+  if (!inside) {
+    inside = true;
+    since = timestamp;
+  }
+  return timestamp - since >= duration;
+}
+
+void ExitConditionMonitor::reset(QTime timestamp, QTime expectedDuration) {
+  startTime = timestamp;
+  lastTime = timestamp;
+  this->expectedDuration = expectedDuration;
+  hasError = false;
+  smallWindow = Window();
+  largeWindow = Window();
+  velocityWindow = Window();
+  stallWindow = Window();
+}
+
+exitReason ExitConditionMonitor::update(const ExitConditions& conditions,
+                                        double error,
+                                        const SensorFrame& frame,
+                                        QTime timestamp) {
+  double magnitude = std::fabs(error);
+  double velocity = INFINITY;
+  double deltaTime = (timestamp - lastTime).convert(second);
+  if (hasError && deltaTime > 0 && std::isfinite(error)) {
+    velocity = std::fabs(error - lastError) / deltaTime;
+  }
+  if (deltaTime > 0 || !hasError) {
+    lastError = error;
+    lastTime = timestamp;
+    hasError = true;
+  }
+
+  double current = 0;
+  double speed = 0;
+  std::size_t motors = frame.leftMotorCount + frame.rightMotorCount;
+  for (std::size_t i = 0; i < frame.leftMotorCount; i++) {
+    current += std::fabs(frame.leftMotors[i].current);
+    speed += std::fabs(frame.leftMotors[i].velocity.convert(rpm));
+  }
+  for (std::size_t i = 0; i < frame.rightMotorCount; i++) {
+    current += std::fabs(frame.rightMotors[i].current);
+    speed += std::fabs(frame.rightMotors[i].velocity.convert(rpm));
+  }
+  bool stalled = motors > 0 &&
+                 current / motors >= conditions.stallCurrent &&
+                 speed / motors <= conditions.stallVelocity.convert(rpm);
+
+  if (smallWindow.update(magnitude <= conditions.smallError, timestamp,
+                         conditions.smallErrorTime)) {
+    return exit_small_error;
+  }
+  if (largeWindow.update(magnitude <= conditions.largeError, timestamp,
+                         conditions.largeErrorTime)) {
+    return exit_large_error;
+  }
+  if (velocityWindow.update(magnitude <= conditions.largeError &&
+                                velocity <= conditions.minVelocity,
+                            timestamp, conditions.velocityTime)) {
+    return exit_velocity;
+  }
+  if (stallWindow.update(stalled, timestamp, conditions.stallTime)) {
+    return exit_stall;
+  }
+  if (conditions.timeout > QTime() &&
+      timestamp - startTime >= conditions.timeout + expectedDuration) {
+    return exit_timeout;
+  }
+  return exit_none;
+}
+}  // namespace apollo
@@ -0,0 +1,82 @@
+#include "apollo/chassis/gpsCorrection.hpp"
+
+#include <cmath>
+
+namespace apollo {
+GpsCorrection::GpsCorrection() { reset(); }
+GpsCorrection::GpsCorrection(Parameters parameters)
+    : parameters(parameters) {
+  reset();
+}
+void GpsCorrection::setParameters(Parameters parameters) {
+  this->parameters = parameters;
+  reset();
+}
+
+void GpsCorrection::recordPose(const Pose& odometryPose) {
+  if (!history.empty()) {
+    const Pose& last = history.newest();
+    double travelled =
+        hypot(odometryPose.x - last.x, odometryPose.y - last.y).convert(meter);
+    variance += std::pow(parameters.driftPerMeter, 2) * travelled;
+  }
+  history.push(odometryPose);
+}
+
+GpsCorrection::sampleResult GpsCorrection::addSample(
+    const GpsSample& sample) {
+  if (hasLastSample && sample.x == lastSample.x && sample.y == lastSample.y &&
+      sample.error == lastSample.error &&
+      sample.timestamp - lastSample.timestamp < parameters.repeatWindow) {
+    return sample_repeated;
+  }
+  lastSample = sample;
+  hasLastSample = true;
+  if (sample.error > parameters.maxError) {
+    return sample_rejected_error;
+  }
+  Pose past;
+  if (!history.sample(sample.timestamp - parameters.latency, past)) {
+    return sample_rejected_no_history;
+  }
+  double innovationX = (sample.x - (past.x + offsetX)).convert(meter);
+  double innovationY = (sample.y - (past.y + offsetY)).convert(meter);
+  double gpsError = std::fmax(sample.error.convert(meter),
+                              parameters.minError.convert(meter));
+  double innovationVariance = variance + gpsError * gpsError;
+  if (innovationX * innovationX + innovationY * innovationY >
+      parameters.outlierGate * parameters.outlierGate * innovationVariance) {
+    // A long run of rejections means odometry has drifted past the gate, not
+    // that every fix is bad, so reopen the gate rather than never recover.
+    if (++consecutiveOutliers >= parameters.maxConsecutiveOutliers) {
+      variance += std::pow(parameters.initialError.convert(meter), 2);
+      consecutiveOutliers = 0;
+    }
+    return sample_rejected_outlier;
+  }
+  consecutiveOutliers = 0;
+  double gain = variance / innovationVariance;
+  offsetX += gain * innovationX * meter;
+  offsetY += gain * innovationY * meter;
+  variance *= 1 - gain;
+  return sample_accepted;
+}
+
+Pose GpsCorrection::apply(const Pose& odometryPose) const {
+  Pose pose = odometryPose;
+  pose.x += offsetX;
+  pose.y += offsetY;
+  return pose;
+}
+
+void GpsCorrection::reset() {
+  history.clear();
+  offsetX = QLength();
+  offsetY = QLength();
+  variance = std::pow(parameters.initialError.convert(meter), 2);
+  consecutiveOutliers = 0;
+  hasLastSample = false;
+}
+QLength GpsCorrection::getOffsetX() const { return offsetX; }
+QLength GpsCorrection::getOffsetY() const { return offsetY; }
+}  // namespace apollo
@@ -0,0 +1,104 @@
+#include "apollo/chassis/hDrive.hpp"
+
+#include <cmath>
+
+#include "pros/misc.h"
+
+namespace apollo {
+HDrive::HDrive(std::vector<int> leftDriveMotorPorts,
+               std::vector<int> rightDriveMotorPorts,
+               std::vector<int> strafeMotorPorts, int inertialSensorPort,
+               double cartridgeRPM, double gearRatio, double wheelDiameter,
+               double strafeGearRatio, double strafeWheelDiameter,
+               QLength trackWidth)
+    : Tank(leftDriveMotorPorts, rightDriveMotorPorts, inertialSensorPort,
+           cartridgeRPM, gearRatio, wheelDiameter),
+      strafeMotors(strafeMotorPorts),
+      strafeGearRatio(strafeGearRatio),
+      strafeWheelCircumference(strafeWheelDiameter * M_PI) {
+  strafeMotors.setEncoderUnits(E_MOTOR_ENCODER_DEGREES);
+  chassisType = h_drive;
+  setTrackingOffsets(trackWidth / 2, trackWidth / 2);
+}
+
+void HDrive::applySensorReset() {
+  strafeMotors.tarePosition();
+  Tank::applySensorReset();
+}
+// The strafe wheels stand in for a center tracker, so their travel is
+// counted in drive tracker ticks. Strafing right counts negative.
+void HDrive::sampleSensors() {
+  Tank::sampleSensors();
+  if (trackerType == tracker_motor_integrated && trackerTickPerInch != 0) {
+    double strafeInches = strafeMotors.getPosition().convert(degree) / 360 *
+                          strafeGearRatio * strafeWheelCircumference;
+    sensorFrame.centerTrackerCount = strafeInches * -1 * trackerTickPerInch;
+  }
+}
+bool HDrive::runMotion(const Pose& pose) {
+  if (!Tank::runMotion(pose)) {
+    return false;
+  }
+  strafeMotors.moveVoltage(0);
+  return true;
+}
+
+void HDrive::setBrakeMode(motor_brake_mode_e_t mode) {
+  Tank::setBrakeMode(mode);
+  strafeMotors.setBrakeMode(mode);
+}
+
+void HDrive::moveVelocity(const HolonomicSpeeds& speeds) {
+  moveWheels(getKinematics().inverse(speeds));
+}
+void HDrive::moveWheels(const HDriveVelocities& velocities) {
+  QSpeed sideSpeed = getTopSpeed();
+  QSpeed strafeSpeed = getTopStrafeSpeed();
+  HDriveVelocities wheels = desaturate(velocities, sideSpeed, strafeSpeed);
+  double sideVolts =
+      sideSpeed > 0 * mps ? maxVoltage / sideSpeed.convert(mps) : 0;
+  double strafeVolts =
+      strafeSpeed > 0 * mps ? maxVoltage / strafeSpeed.convert(mps) : 0;
+  leftDriveMotors.moveVoltage(wheels.left.convert(mps) * sideVolts);
+  rightDriveMotors.moveVoltage(wheels.right.convert(mps) * sideVolts);
+  strafeMotors.moveVoltage(wheels.strafe.convert(mps) * strafeVolts);
+}
+
+// Axes are shaped by the drive and turn curves into fractions of full
+// stick. The sides scale with the top drive wheel speed, strafe with the
+// top strafe wheel speed.
+void HDrive::setTank(controller_analog_e_t leftAxis,
+                     controller_analog_e_t rightAxis,
+                     controller_analog_e_t* strafeAxis) {
+  driveWheels((*driveCurve)(readAxis(leftAxis)),
+              (*driveCurve)(readAxis(rightAxis)),
+              strafeAxis ? (*driveCurve)(readAxis(*strafeAxis)) : 0);
+}
+void HDrive::setArcade(controller_analog_e_t leftAxis,
+                       controller_analog_e_t rightAxis,
+                       controller_analog_e_t* strafeAxis) {
+  double forward = (*driveCurve)(readAxis(leftAxis));
+  double turn = (*turnCurve)(readAxis(rightAxis));
+  driveWheels(forward + turn, forward - turn,
+              strafeAxis ? (*driveCurve)(readAxis(*strafeAxis)) : 0);
+}
+void HDrive::driveWheels(double left, double right, double strafe) {
+  QSpeed topSpeed = getTopSpeed();
+  moveWheels({topSpeed * slewDriverOutput(left, leftDriverOutput),
+              topSpeed * slewDriverOutput(right, rightDriverOutput),
+              getTopStrafeSpeed() *
+                  (slewDriverOutput(strafe, strafeDriverOutput) *
+                   strafeScale)});
+}
+
+void HDrive::setStrafeScale(double scale) { strafeScale = scale; }
+HDriveKinematics HDrive::getKinematics() const {
+  return HDriveKinematics(getTrackWidth());
+}
+// The strafe motors share the drive cartridge and maxVelocity cap.
+QSpeed HDrive::getTopStrafeSpeed() const {
+  return (maxVelocity / drivetrainGearRatio * strafeGearRatio *
+          strafeWheelCircumference / 60) *
+         inch / second;
+}
+}  // namespace apollo
@@ -0,0 +1,86 @@
+#include "apollo/chassis/headingFilter.hpp"
+
+#include <cmath>
+
+namespace apollo {
+HeadingFilter::HeadingFilter(Noise noise) : noise(noise) {}
+void HeadingFilter::setNoise(Noise noise) { this->noise = noise; }
+HeadingFilter::Noise HeadingFilter::getNoise() const { return noise; }
+
+void HeadingFilter::reset(QAngle heading) {
+  this->heading = heading;
+  rate = QAngularSpeed();
+  double headingVariance = std::pow(noise.imuHeading.convert(radian), 2);
+  double rateVariance = std::pow(noise.gyroRate.convert(radps), 2);
+  covariance[0][0] = headingVariance;
+  covariance[0][1] = 0;
+  covariance[1][0] = 0;
+  covariance[1][1] = rateVariance;
+}
+
+// Constant rate model driven by white angular acceleration noise.
+void HeadingFilter::predict(QTime deltaTime) {
+  double dt = deltaTime.convert(second);
+  if (dt <= 0) {
+    return;
+  }
+  heading += rate * deltaTime;
+  double q = std::pow(noise.process.convert(radian / (second * second)), 2);
+  double p00 = covariance[0][0] + dt * (covariance[0][1] + covariance[1][0]) +
+               dt * dt * covariance[1][1];
+  double p01 = covariance[0][1] + dt * covariance[1][1];
+  double p10 = covariance[1][0] + dt * covariance[1][1];
+  covariance[0][0] = p00 + q * dt * dt * dt * dt / 4;
+  covariance[0][1] = p01 + q * dt * dt * dt / 2;
+  covariance[1][0] = p10 + q * dt * dt * dt / 2;
+  covariance[1][1] += q * dt * dt;
+}
+
+void HeadingFilter::updateHeading(QAngle heading) {
+  correct(heading, noise.imuHeading, 0);
+}
+void HeadingFilter::updateGyroRate(QAngularSpeed rate) {
+  correct(rate, noise.gyroRate, 0);
+}
+bool HeadingFilter::updateWheelRate(QAngularSpeed rate) {
+  return correct(rate, noise.wheelRate, noise.slipGate);
+}
+
+bool HeadingFilter::correct(QAngle measurement, QAngle deviation,
+                            double gate) {
+  return correctState(0, (measurement - heading).convert(radian),
+                      std::pow(deviation.convert(radian), 2), gate);
+}
+bool HeadingFilter::correct(QAngularSpeed measurement,
+                            QAngularSpeed deviation, double gate) {
+  return correctState(1, (measurement - rate).convert(radps),
+                      std::pow(deviation.convert(radps), 2), gate);
+}
+
+// Scalar measurement of a single state, so the update is a handful of
+// multiplies rather than a matrix inverse.
+bool HeadingFilter::correctState(int state, double innovation,
+                                 double variance, double gate) {
+  double innovationVariance = covariance[state][state] + variance;
+  if (gate > 0 &&
+      innovation * innovation > gate * gate * innovationVariance) {
+    return false;
+  }
+  double gain0 = covariance[0][state] / innovationVariance;
+  double gain1 = covariance[1][state] / innovationVariance;
+  heading += gain0 * innovation * radian;
+  rate += gain1 * innovation * radps;
+  double p00 = covariance[0][0] - gain0 * covariance[state][0];
+  double p01 = covariance[0][1] - gain0 * covariance[state][1];
+  double p10 = covariance[1][0] - gain1 * covariance[state][0];
+  double p11 = covariance[1][1] - gain1 * covariance[state][1];
+  covariance[0][0] = p00;
+  covariance[0][1] = p01;
+  covariance[1][0] = p10;
+  covariance[1][1] = p11;
+  return true;
+}
+
+QAngle HeadingFilter::getHeading() const { return heading; }
+QAngularSpeed HeadingFilter::getRate() const { return rate; }
+}  // namespace apollo
@@ -0,0 +1,18 @@
+#include "apollo/chassis/mecanum.hpp"
+
+namespace apollo {
+Mecanum::Mecanum(std::vector<int> frontLeftMotorPorts,
+                 std::vector<int> frontRightMotorPorts,
+                 std::vector<int> backLeftMotorPorts,
+                 std::vector<int> backRightMotorPorts, int inertialSensorPort,
+                 double cartridgeRPM, double gearRatio, double wheelDiameter,
+                 QLength trackWidth, QLength wheelBase)
+    : HolonomicDrive({frontLeftMotorPorts, frontRightMotorPorts,
+                      backLeftMotorPorts, backRightMotorPorts},
+                     inertialSensorPort, cartridgeRPM, gearRatio,
+                     wheelDiameter, mecanumKinematics(trackWidth, wheelBase)) {
+}
+void Mecanum::setDimensions(QLength trackWidth, QLength wheelBase) {
+  setKinematics(mecanumKinematics(trackWidth, wheelBase));
+}
+}  // namespace apollo
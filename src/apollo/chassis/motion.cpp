@@ -0,0 +1,81 @@
+#include "apollo/chassis/motion.hpp"
+
+#include <cmath>
+
+#include "pros/rtos.hpp"
+
+namespace apollo {
+Motion::Motion() : state(std::make_shared<MotionState>()) {}
+void Motion::start(const MotionContext& context) {
+  startTime = context.timestamp;
+  lastTime = context.timestamp;
+  exitMonitor.reset(context.timestamp, expectedDuration);
+}
+std::shared_ptr<MotionState> Motion::getState() const { return state; }
+
+void Motion::setExitConditions(const ExitConditions& conditions) {
+  exitConditions = conditions;
+}
+
+void Motion::setChained(bool chained) { this->chained = chained; }
+bool Motion::isChained() const { return chained; }
+QSpeed Motion::getHandoffVelocity() const { return QSpeed(); }
+
+bool Motion::updateSettled(double error, const MotionContext& context) {
+  exitReason reason = exitMonitor.update(exitConditions, error, context.frame,
+                                         context.timestamp);
+  if (chained && std::fabs(error) <= exitConditions.largeError) {
+    reason = exit_handoff;
+  }
+  if (reason != exit_none) {
+    settle(reason, context.timestamp);
+  }
+  return state->settled;
+}
+// The first reason wins, so a cancel after settling doesn't overwrite it.
+void Motion::settle(exitReason reason, QTime timestamp) {
+  if (state->settled) {
+    return;
+  }
+  state->exitTime = (timestamp - startTime).convert(second);
+  state->reason = reason;
+  state->settled = true;
+}
+
+MotionHandle::MotionHandle(std::shared_ptr<MotionState> state)
+    : state(std::move(state)) {}
+
+void MotionHandle::waitUntilSettled() const {
+  while (state && !state->settled) {
+    pros::delay(10);
+  }
+}
+void MotionHandle::waitUntil(QLength distance) const {
+  waitUntilProgress(distance.convert(meter));
+}
+void MotionHandle::waitUntil(QAngle angle) const {
+  waitUntilProgress(angle.convert(radian));
+}
+void MotionHandle::waitUntilProgress(double progress) const {
+  while (state && !state->settled &&
+         std::fabs(state->progress) < std::fabs(progress)) {
+    pros::delay(10);
+  }
+}
+
+void MotionHandle::cancel() {
+  if (state) {
+    state->cancelled = true;
+  }
+}
+bool MotionHandle::isSettled() const { return !state || state->settled; }
+double MotionHandle::getProgress() const {
+  return state ? state->progress.load() : 0;
+}
+exitReason MotionHandle::getExitReason() const {
+  return state ? state->reason.load() : exit_none;
+}
+QTime MotionHandle::getExitTime() const {
+  return state ? state->exitTime * second : QTime();
+}
+}  // namespace apollo
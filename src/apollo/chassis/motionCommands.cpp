@@ -0,0 +1,128 @@
+#include "apollo/chassis/motionCommands.hpp"
+
+#include <algorithm>
+
+namespace apollo {
+// Profiles are solved in the caller's task, not the control loop, and
+// repeated moves reuse a cached solve. Inside a chain both the profile to
+// rest and the one handing off are solved from the speed the drive is
+// handed over at. The control loop only solves again for a drive started
+// while the robot is moving outside a chain, once, as it starts.
+MotionHandle MotionCommands::drive(QLength targetDistance,
+                                   QSpeed targetVelocity,
+                                   const SideModel& sides) {
+  QSpeed profileSpeed =
+      targetVelocity > 0 * mps && targetVelocity < sides.topSpeed
+          ? targetVelocity
+          : sides.topSpeed;
+  ProfileConstraints constraints{profileSpeed, driveAcceleration, driveJerk};
+  QSpeed entryVelocity, handoffVelocity;
+  motionRunner.getChainSpeeds(targetDistance, entryVelocity, handoffVelocity);
+  MotionProfile stopProfile =
+      profileCache.get(targetDistance, constraints, entryVelocity);
+  MotionProfile handoffProfile =
+      handoffVelocity == QSpeed()
+          ? stopProfile
+          : profileCache.get(targetDistance, constraints, entryVelocity,
+                             handoffVelocity);
+  return start(std::make_shared<DriveMotion>(
+                   stopProfile, handoffProfile,
+                   outputForSpeed(targetVelocity, sides), driveGains,
+                   headingGains, getFeedforward(sides)),
+               driveExit);
+}
+MotionHandle MotionCommands::turn(QAngle targetAngle,
+                                  QAngularSpeed targetVelocity,
+                                  const SideModel& sides) {
+  QSpeed sideSpeed =
+      (targetVelocity.convert(radps) * sides.trackWidth / 2) / second;
+  return start(std::make_shared<TurnMotion>(targetAngle,
+                                            outputForSpeed(sideSpeed, sides),
+                                            turnGains),
+               turnExit);
+}
+MotionHandle MotionCommands::swing(direction targetDirection,
+                                   QAngle targetAngle,
+                                   QAngularSpeed targetVelocity,
+                                   const SideModel& sides) {
+  QSpeed sideSpeed =
+      (targetVelocity.convert(radps) * sides.trackWidth) / second;
+  return start(std::make_shared<SwingMotion>(
+                   targetDirection, targetAngle,
+                   outputForSpeed(sideSpeed, sides), swingGains, driveGains),
+               turnExit);
+}
+MotionHandle MotionCommands::followPath(std::vector<Waypoint> path,
+                                        QLength lookahead,
+                                        QSpeed targetVelocity,
+                                        const SideModel& sides) {
+  return start(std::make_shared<PathMotion>(
+                   std::move(path), lookahead, sides.trackWidth,
+                   outputForSpeed(targetVelocity, sides), driveGains),
+               driveExit);
+}
+MotionHandle MotionCommands::followTrajectory(
+    std::shared_ptr<const TrajectorySource> trajectory,
+    const SideModel& sides) {
+  return start(std::make_shared<TrajectoryMotion>(
+                   std::move(trajectory), ramseteController,
+                   sides.trackWidth, getFeedforward(sides), sides.maxVoltage),
+               driveExit);
+}
+
+MotionHandle MotionCommands::start(std::shared_ptr<Motion> motion) {
+  return motionRunner.start(std::move(motion));
+}
+MotionHandle MotionCommands::start(std::shared_ptr<Motion> motion,
+                                   const ExitConditions& conditions) {
+  motion->setExitConditions(conditions);
+  return start(std::move(motion));
+}
+void MotionCommands::cancel() { motionRunner.cancel(); }
+void MotionCommands::beginChain(QSpeed handoffVelocity) {
+  motionRunner.beginChain(handoffVelocity);
+}
+void MotionCommands::endChain() { motionRunner.endChain(); }
+bool MotionCommands::run(const MotionContext& context, DriveOutput& output) {
+  return motionRunner.run(context, output);
+}
+
+void MotionCommands::setDriveGains(PIDGains gains) { driveGains = gains; }
+void MotionCommands::setHeadingGains(PIDGains gains) { headingGains = gains; }
+void MotionCommands::setTurnGains(PIDGains gains) { turnGains = gains; }
+void MotionCommands::setSwingGains(PIDGains gains) { swingGains = gains; }
+void MotionCommands::setRamseteGains(double b, double zeta) {
+  ramseteController.setGains(b, zeta);
+}
+void MotionCommands::setDriveConstraints(QAcceleration acceleration,
+                                         QJerk jerk) {
+  driveAcceleration = acceleration;
+  driveJerk = jerk;
+}
+void MotionCommands::setFeedforward(FeedforwardGains gains) {
+  feedforwardGains = gains;
+}
+Feedforward MotionCommands::getFeedforward(const SideModel& sides) const {
+  if (feedforwardGains.kV > 0 || sides.topSpeed <= 0 * mps) {
+    return Feedforward(feedforwardGains);
+  }
+  return Feedforward({0, sides.maxVoltage / sides.topSpeed.convert(mps), 0});
+}
+void MotionCommands::setDriveExitConditions(
+    const ExitConditions& conditions) {
+  driveExit = conditions;
+}
+void MotionCommands::setTurnExitConditions(const ExitConditions& conditions) {
+  turnExit = conditions;
+}
+
+// Scales the output cap by the requested share of the top side speed.
+double MotionCommands::outputForSpeed(QSpeed sideSpeed,
+                                      const SideModel& sides) {
+  if (sides.topSpeed <= 0 * mps || sideSpeed <= 0 * mps) {
+    return sides.maxVoltage;
+  }
+  return std::min(1.0, (sideSpeed / sides.topSpeed).getValue()) *
+         sides.maxVoltage;
+}
+}  // namespace apollo
@@ -0,0 +1,127 @@
+#include "apollo/chassis/motionRunner.hpp"
+
+namespace apollo {
+MotionHandle MotionRunner::start(std::shared_ptr<Motion> motion) {
+  MotionHandle handle(motion->getState());
+  mutex.take(TIMEOUT_MAX);
+  if (chaining) {
+    // Everything up to the last motion of the chain hands off.
+    motion->setChained(true);
+    lastChained = motion;
+    queuedMotions.push_back(std::move(motion));
+  } else {
+    clearQueued();
+    if (pendingMotion) {
+      pendingMotion->getState()->cancelled = true;
+      pendingMotion->getState()->reason = exit_cancelled;
+      pendingMotion->getState()->settled = true;
+    }
+    pendingMotion = std::move(motion);
+  }
+  mutex.give();
+  return handle;
+}
+void MotionRunner::cancel() {
+  mutex.take(TIMEOUT_MAX);
+  clearQueued();
+  if (pendingMotion) {
+    pendingMotion->getState()->reason = exit_cancelled;
+    pendingMotion->getState()->settled = true;
+    pendingMotion.reset();
+  }
+  cancelRequested = true;
+  mutex.give();
+}
+
+void MotionRunner::beginChain(QSpeed handoffVelocity) {
+  mutex.take(TIMEOUT_MAX);
+  chaining = true;
+  chainVelocity = handoffVelocity;
+  lastChained.reset();
+  mutex.give();
+}
+void MotionRunner::endChain() {
+  mutex.take(TIMEOUT_MAX);
+  chaining = false;
+  if (lastChained) {
+    lastChained->setChained(false);
+    lastChained.reset();
+  }
+  mutex.give();
+}
+QSpeed MotionRunner::getChainVelocity() const { return chainVelocity; }
+void MotionRunner::getChainSpeeds(QLength distance, QSpeed& entryVelocity,
+                                  QSpeed& handoffVelocity) {
+  mutex.take(TIMEOUT_MAX);
+  entryVelocity = chaining && lastChained ? lastChained->getHandoffVelocity()
+                                          : QSpeed();
+  handoffVelocity = chaining ? abs(chainVelocity) : QSpeed();
+  if (distance < QLength()) {
+    handoffVelocity = handoffVelocity * -1;
+  }
+  mutex.give();
+}
+
+bool MotionRunner::run(const MotionContext& context, DriveOutput& output) {
+  if (cancelRequested.exchange(false) && activeMotion) {
+    activeMotion->getState()->cancelled = true;
+  }
+  // Never block the control task on a caller holding the mutex; the new
+  // motion is picked up on the next tick instead.
+  bool locked = mutex.take(0);
+  if (locked && pendingMotion) {
+    if (activeMotion) {
+      activeMotion->getState()->cancelled = true;
+      activeMotion->settle(exit_cancelled, context.timestamp);
+    }
+    activeMotion = std::move(pendingMotion);
+    pendingMotion.reset();
+    activeMotion->start(context);
+  }
+  if (locked && !activeMotion) {
+    activeMotion = popQueued(context);
+  }
+  bool ran = activeMotion != nullptr;
+  output = DriveOutput();
+  while (activeMotion) {
+    std::shared_ptr<MotionState> state = activeMotion->getState();
+    if (!state->cancelled) {
+      output = activeMotion->step(context);
+    }
+    if (!state->cancelled && !state->settled) {
+      break;
+    }
+    activeMotion->settle(exit_cancelled, context.timestamp);
+    activeMotion.reset();
+    output = DriveOutput();
+    // A handoff starts the next chained motion on the same tick, so the
+    // drive never sees a zero output between them.
+    if (locked && state->reason == exit_handoff) {
+      activeMotion = popQueued(context);
+    }
+  }
+  if (locked) {
+    mutex.give();
+  }
+  return ran;
+}
+
+// popQueued and clearQueued are called with the mutex held.
+std::shared_ptr<Motion> MotionRunner::popQueued(const MotionContext& context) {
+  if (queuedMotions.empty()) {
+    return nullptr;
+  }
+  std::shared_ptr<Motion> motion = std::move(queuedMotions.front());
+  queuedMotions.pop_front();
+  motion->start(context);
+  return motion;
+}
+void MotionRunner::clearQueued() {
+  for (std::shared_ptr<Motion>& motion : queuedMotions) {
+    motion->getState()->cancelled = true;
+    motion->getState()->reason = exit_cancelled;
+    motion->getState()->settled = true;
+  }
+  queuedMotions.clear();
+}
+}  // namespace apollo
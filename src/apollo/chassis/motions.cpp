@@ -0,0 +1,253 @@
+#include "apollo/chassis/motions.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "apollo/util/math.hpp"
+
+namespace apollo {
+namespace {
+// Below this the drive counts as starting from rest.
+constexpr double restingSpeed = 0.05;  // m/s
+
+// Odometry heading is continuous, so it can be whole turns away from a
+// target in [-180, 180). Turns take the shortest way round instead of
+// unwinding those turns.
+double headingError(QAngle target, QAngle heading) {
+  return math::wrapRadians((target - heading).convert(radian));
+}
+}  // namespace
+
+DriveMotion::DriveMotion(const MotionProfile& stopProfile,
+                         const MotionProfile& handoffProfile,
+                         double maxOutput, PIDGains driveGains,
+                         PIDGains headingGains, Feedforward feedforward)
+    : profile(stopProfile),
+      stopProfile(stopProfile),
+      handoffProfile(handoffProfile),
+      feedforward(feedforward),
+      distance(stopProfile.getDistance()),
+      maxOutput(maxOutput),
+      drivePID(driveGains),
+      headingPID(headingGains) {
+  expectedDuration = profile.getDuration();
+}
+DriveMotion::DriveMotion(const MotionProfile& profile, double maxOutput,
+                         PIDGains driveGains, PIDGains headingGains,
+                         Feedforward feedforward)
+    : DriveMotion(profile, profile, maxOutput, driveGains, headingGains,
+                  feedforward) {}
+// Whether the drive still hands off is only known once it starts. A drive
+// that starts moving without being handed over, e.g. one replacing a
+// running motion, is the one case solved again here: a single solve into
+// the fixed segment array, on the tick the drive starts.
+void DriveMotion::start(const MotionContext& context) {
+  profile = isChained() ? handoffProfile : stopProfile;
+  QSpeed velocity = (context.leftVelocity + context.rightVelocity) / 2;
+  if (profile.getStartVelocity() == QSpeed() &&
+      abs(velocity).convert(mps) > restingSpeed) {
+    profile = MotionProfile(distance, profile.getConstraints(), velocity,
+                            profile.getEndVelocity());
+  }
+  expectedDuration = profile.getDuration();
+  Motion::start(context);
+  startLeft = context.leftDistance;
+  startRight = context.rightDistance;
+  targetHeading = context.pose.theta;
+}
+DriveOutput DriveMotion::step(const MotionContext& context) {
+  QTime deltaTime = context.timestamp - lastTime;
+  lastTime = context.timestamp;
+  QLength travelled = ((context.leftDistance - startLeft) +
+                       (context.rightDistance - startRight)) /
+                      2;
+  state->progress = travelled.convert(meter);
+  // The error windows only open once the profile has finished, so a short
+  // move can't count as settled before it has started. A chained drive
+  // hands off only once it reaches the target, since the next drive is
+  // measured from wherever this one ends.
+  QTime elapsed = context.timestamp - startTime;
+  double remaining = (distance - travelled).convert(meter);
+  double error = remaining;
+  if (isChained()) {
+    if (remaining * distance.convert(meter) <= 0) {
+      settle(exit_handoff, context.timestamp);
+    }
+    error = INFINITY;
+  } else if (elapsed < expectedDuration) {
+    error = INFINITY;
+  }
+  ProfileSetpoint setpoint = profile.sample(elapsed);
+  if (!isChained() && elapsed >= expectedDuration) {
+    // Unchained after it started: hold the target instead of driving on.
+    setpoint.velocity = QSpeed();
+  }
+  // The setpoint moves along the profile, so the derivative acts on the
+  // velocity tracking error rather than against the feedforward.
+  QSpeed velocity = (context.leftVelocity + context.rightVelocity) / 2;
+  double drive = math::clipValues(
+      feedforward.calculate(setpoint.velocity, setpoint.acceleration) +
+          drivePID
+              .step(setpoint.position, travelled, setpoint.velocity, velocity,
+                    deltaTime)
+              .getValue(),
+      maxOutput, -maxOutput);
+  double turn = math::clipValues(
+      headingPID.step(targetHeading, context.pose.theta, deltaTime)
+          .getValue(),
+      maxOutput, -maxOutput);
+  if (updateSettled(error, context)) {
+    return DriveOutput();
+  }
+  return {math::clipValues(drive - turn, maxOutput, -maxOutput),
+          math::clipValues(drive + turn, maxOutput, -maxOutput)};
+}
+
+QSpeed DriveMotion::getHandoffVelocity() const {
+  return handoffProfile.getEndVelocity();
+}
+
+TurnMotion::TurnMotion(QAngle targetAngle, double maxOutput,
+                       PIDGains turnGains)
+    : targetAngle(targetAngle), maxOutput(maxOutput), turnPID(turnGains) {
+  exitConditions = defaultTurnExit;
+}
+void TurnMotion::start(const MotionContext& context) {
+  Motion::start(context);
+  startAngle = context.pose.theta;
+}
+DriveOutput TurnMotion::step(const MotionContext& context) {
+  QTime deltaTime = context.timestamp - lastTime;
+  lastTime = context.timestamp;
+  state->progress = (context.pose.theta - startAngle).convert(radian);
+  double error = headingError(targetAngle, context.pose.theta);
+  double turn = math::clipValues(
+      turnPID
+          .step(context.pose.theta + error * radian, context.pose.theta,
+                deltaTime)
+          .getValue(),
+      maxOutput, -maxOutput);
+  if (updateSettled(error, context)) {
+    return DriveOutput();
+  }
+  return {-turn, turn};
+}
+
+SwingMotion::SwingMotion(direction side, QAngle targetAngle, double maxOutput,
+                         PIDGains swingGains, PIDGains holdGains)
+    : side(side),
+      targetAngle(targetAngle),
+      maxOutput(maxOutput),
+      swingPID(swingGains),
+      holdPID(holdGains) {
+  exitConditions = defaultTurnExit;
+}
+void SwingMotion::start(const MotionContext& context) {
+  Motion::start(context);
+  startAngle = context.pose.theta;
+  startLeft = context.leftDistance;
+  startRight = context.rightDistance;
+}
+DriveOutput SwingMotion::step(const MotionContext& context) {
+  QTime deltaTime = context.timestamp - lastTime;
+  lastTime = context.timestamp;
+  state->progress = (context.pose.theta - startAngle).convert(radian);
+  double error = headingError(targetAngle, context.pose.theta);
+  double swing = math::clipValues(
+      swingPID
+          .step(context.pose.theta + error * radian, context.pose.theta,
+                deltaTime)
+          .getValue(),
+      maxOutput, -maxOutput);
+  if (updateSettled(error, context)) {
+    return DriveOutput();
+  }
+  // A counter-clockwise swing drives the left side backwards or the right
+  // side forwards.
+  if (side == LEFT) {
+    double hold =
+        holdPID.step(startRight, context.rightDistance, deltaTime).getValue();
+    return {-swing, math::clipValues(hold, maxOutput, -maxOutput)};
+  }
+  double hold =
+      holdPID.step(startLeft, context.leftDistance, deltaTime).getValue();
+  return {math::clipValues(hold, maxOutput, -maxOutput), swing};
+}
+
+PathMotion::PathMotion(std::vector<Waypoint> path, QLength lookahead,
+                       QLength trackWidth, double maxOutput,
+                       PIDGains driveGains)
+    : pursuit(std::move(path), lookahead),
+      trackWidth(trackWidth),
+      maxOutput(maxOutput),
+      drivePID(driveGains) {
+  // Allow for an average of half a meter per second along the path.
+  expectedDuration = pursuit.getLength().convert(meter) * 2 * second;
+}
+void PathMotion::start(const MotionContext& context) {
+  Motion::start(context);
+  pursuit.reset();
+}
+DriveOutput PathMotion::step(const MotionContext& context) {
+  QTime deltaTime = context.timestamp - lastTime;
+  lastTime = context.timestamp;
+  double curvature = pursuit.update(context.pose);
+  QLength travelled = pursuit.getTravelled();
+  state->progress = travelled.convert(meter);
+  double drive = math::clipValues(
+      drivePID.step(pursuit.getLength(), travelled, deltaTime).getValue(),
+      maxOutput, -maxOutput);
+  if (updateSettled(pursuit.getRemaining().convert(meter), context)) {
+    return DriveOutput();
+  }
+  double turn = curvature * trackWidth.convert(meter) / 2;
+  double left = drive * (1 - turn);
+  double right = drive * (1 + turn);
+  // Scale both sides together so the arc is kept when one side saturates.
+  double largest = std::max(std::fabs(left), std::fabs(right));
+  if (largest > maxOutput) {
+    left *= maxOutput / largest;
+    right *= maxOutput / largest;
+  }
+  return {left, right};
+}
+
+TrajectoryMotion::TrajectoryMotion(
+    std::shared_ptr<const TrajectorySource> trajectory,
+    RamseteController controller, QLength trackWidth, Feedforward feedforward,
+    double maxOutput)
+    : trajectory(std::move(trajectory)),
+      controller(controller),
+      trackWidth(trackWidth),
+      feedforward(feedforward),
+      maxOutput(maxOutput) {
+  expectedDuration = this->trajectory->getDuration();
+}
+DriveOutput TrajectoryMotion::step(const MotionContext& context) {
+  QTime elapsed = context.timestamp - startTime;
+  TrajectoryPoint reference = trajectory->sample(elapsed);
+  state->progress = reference.distance.convert(meter);
+  double error = elapsed < expectedDuration
+                     ? INFINITY
+                     : hypot(reference.pose.x - context.pose.x,
+                             reference.pose.y - context.pose.y)
+                           .convert(meter);
+  if (updateSettled(error, context)) {
+    return DriveOutput();
+  }
+  WheelVelocities wheels =
+      controller.step(context.pose, reference, trackWidth);
+  // Each wheel's share of the reference acceleration through the curve.
+  double turn = reference.curvature * trackWidth.convert(meter) / 2;
+  double left =
+      feedforward.calculate(wheels.left, reference.acceleration * (1 - turn));
+  double right =
+      feedforward.calculate(wheels.right, reference.acceleration * (1 + turn));
+  double largest = std::max(std::fabs(left), std::fabs(right));
+  if (largest > maxOutput) {
+    left *= maxOutput / largest;
+    right *= maxOutput / largest;
+  }
+  return {left, right};
+}
+}  // namespace apollo
@@ -0,0 +1,110 @@
+#include "apollo/chassis/motorGroup.hpp"
+
+#include "apollo/util/util.hpp"
+
+namespace apollo {
+MotorGroup::MotorGroup(std::vector<int> motorPorts) {
+  for (auto i : motorPorts) {
+    motors.push_back(pros::Motor(std::abs(i), util::isNegative(i)));
+  }
+}
+
+void MotorGroup::moveVoltage(std::int32_t voltage) {
+  if (lastCommandMode == command_voltage && lastCommand == voltage) {
+    return;
+  }
+  for (auto& motor : motors) {
+    motor.move_voltage(voltage);
+  }
+  lastCommandMode = command_voltage;
+  lastCommand = voltage;
+}
+void MotorGroup::moveVelocity(std::int32_t velocity) {
+  if (lastCommandMode == command_velocity && lastCommand == velocity) {
+    return;
+  }
+  for (auto& motor : motors) {
+    motor.move_velocity(velocity);
+  }
+  lastCommandMode = command_velocity;
+  lastCommand = velocity;
+}
+void MotorGroup::setBrakeMode(pros::motor_brake_mode_e_t mode) {
+  if (brakeMode == mode) {
+    return;
+  }
+  for (auto& motor : motors) {
+    motor.set_brake_mode(mode);
+  }
+  brakeMode = mode;
+}
+void MotorGroup::setCurrentLimit(std::int32_t limit) {
+  if (currentLimit == limit) {
+    return;
+  }
+  for (auto& motor : motors) {
+    motor.set_current_limit(limit);
+  }
+  currentLimit = limit;
+}
+void MotorGroup::setEncoderUnits(pros::motor_encoder_units_e_t units) {
+  for (auto& motor : motors) {
+    motor.set_encoder_units(units);
+  }
+}
+void MotorGroup::tarePosition() {
+  for (auto& motor : motors) {
+    motor.tare_position();
+  }
+}
+// Forces the next command through, e.g. after a motor was unplugged and lost
+// its last target.
+void MotorGroup::invalidate() {
+  lastCommandMode = command_none;
+  brakeMode = pros::E_MOTOR_BRAKE_INVALID;
+  currentLimit = -1;
+}
+
+QAngle MotorGroup::getPosition() const {
+  if (motors.empty()) {
+    return QAngle();
+  }
+  double total = 0;
+  for (const auto& motor : motors) {
+    total += motor.get_position();
+  }
+  return (total / motors.size()) * degree;
+}
+QAngularSpeed MotorGroup::getVelocity() const {
+  if (motors.empty()) {
+    return QAngularSpeed();
+  }
+  double total = 0;
+  for (const auto& motor : motors) {
+    total += motor.get_actual_velocity();
+  }
+  return (total / motors.size()) * rpm;
+}
+std::int32_t MotorGroup::getCurrentDraw() const {
+  std::int32_t total = 0;
+  for (const auto& motor : motors) {
+    total += motor.get_current_draw();
+  }
+  return total;
+}
+pros::motor_brake_mode_e_t MotorGroup::getBrakeMode() const {
+  return brakeMode;
+}
+
+std::size_t MotorGroup::size() const { return motors.size(); }
+pros::Motor& MotorGroup::operator[](std::size_t index) {
+  return motors[index];
+}
+const pros::Motor& MotorGroup::operator[](std::size_t index) const {
+  return motors[index];
+}
+std::vector<pros::Motor>::iterator MotorGroup::begin() {
+  return motors.begin();
+}
+std::vector<pros::Motor>::iterator MotorGroup::end() { return motors.end(); }
+}  // namespace apollo
@@ -0,0 +1,80 @@
+#include "apollo/chassis/odometry.hpp"
+
+#include <cmath>
+
+namespace apollo {
+Odometry::Odometry(TrackerOffsets offsets) : offsets(offsets) {}
+void Odometry::setOffsets(TrackerOffsets offsets) { this->offsets = offsets; }
+Odometry::TrackerOffsets Odometry::getOffsets() const { return offsets; }
+
+void Odometry::update(QLength left, QLength right, QLength center,
+                      QTime timestamp) {
+  if (!initialized) {
+    lastLeft = left;
+    lastRight = right;
+    lastCenter = center;
+    initialized = true;
+  }
+  QLength deltaLeft = left - lastLeft;
+  QLength deltaRight = right - lastRight;
+  QAngle deltaTheta =
+      ((deltaRight - deltaLeft) / (offsets.left + offsets.right)) * radian;
+  integrate(deltaLeft, deltaRight, center - lastCenter, deltaTheta, timestamp);
+  lastLeft = left;
+  lastRight = right;
+  lastCenter = center;
+}
+void Odometry::update(QLength left, QLength right, QLength center,
+                      QAngle heading, QTime timestamp) {
+  if (!initialized) {
+    lastLeft = left;
+    lastRight = right;
+    lastCenter = center;
+    lastHeading = heading;
+    initialized = true;
+  }
+  integrate(left - lastLeft, right - lastRight, center - lastCenter,
+            heading - lastHeading, timestamp);
+  lastLeft = left;
+  lastRight = right;
+  lastCenter = center;
+  lastHeading = heading;
+}
+
+void Odometry::integrate(QLength deltaLeft, QLength deltaRight,
+                         QLength deltaCenter, QAngle deltaTheta,
+                         QTime timestamp) {
+  double dTheta = deltaTheta.convert(radian);
+  QLength forward;
+  QLength lateral;
+  if (std::fabs(dTheta) < 1e-9) {
+    forward = (deltaLeft + deltaRight) / 2;
+    lateral = deltaCenter;
+  } else {
+    // Each tracker sweeps an arc around the same instantaneous center, so
+    // the chord of the tracking center follows from either arc radius.
+    double chord = 2 * std::sin(dTheta / 2);
+    QLength forwardRadius = (deltaLeft + deltaRight) / (2 * dTheta) -
+                            (offsets.right - offsets.left) / 2;
+    forward = chord * forwardRadius;
+    lateral = chord * (deltaCenter / dTheta + offsets.center);
+  }
+  double averageTheta = pose.theta.convert(radian) + dTheta / 2;
+  double cosTheta = std::cos(averageTheta);
+  double sinTheta = std::sin(averageTheta);
+  pose.x += forward * cosTheta - lateral * sinTheta;
+  pose.y += forward * sinTheta + lateral * cosTheta;
+  pose.theta += deltaTheta;
+  pose.timestamp = timestamp;
+}
+
+void Odometry::setPose(const Pose& newPose) { pose = newPose; }
+void Odometry::reset() {
+  pose = Pose();
+  initialized = false;
+}
+Pose Odometry::getPose() const { return pose; }
+QLength Odometry::getX() const { return pose.x; }
+QLength Odometry::getY() const { return pose.y; }
+QAngle Odometry::getTheta() const { return pose.theta; }
+}  // namespace apollo
@@ -0,0 +1,59 @@
+#include "apollo/chassis/slipDetector.hpp"
+
+#include <cmath>
+
+namespace apollo {
+SlipDetector::SlipDetector() : SlipDetector(Parameters()) {}
+SlipDetector::SlipDetector(Parameters parameters)
+    : parameters(parameters) {}
+void SlipDetector::setParameters(Parameters parameters) {
+  this->parameters = parameters;
+}
+
+bool SlipDetector::update(QSpeed wheelSpeed,
+                          QAcceleration measuredAcceleration,
+                          QTime timestamp) {
+  QTime dt = timestamp - lastTimestamp;
+  if (!initialized || dt <= 0 * second) {
+    lastWheelSpeed = wheelSpeed;
+    lastTimestamp = timestamp;
+    imuAcceleration = measuredAcceleration;
+    initialized = true;
+    return slipping;
+  }
+  double alpha = parameters.smoothing;
+  wheelAcceleration += ((wheelSpeed - lastWheelSpeed) / dt -
+                        wheelAcceleration) *
+                       alpha;
+  imuAcceleration += (measuredAcceleration - imuAcceleration) * alpha;
+  lastWheelSpeed = wheelSpeed;
+  lastTimestamp = timestamp;
+
+  double difference =
+      std::fabs((wheelAcceleration - imuAcceleration).convert(mps2));
+  double threshold = parameters.threshold.convert(mps2);
+  if (difference > threshold) {
+    if (!mismatched) {
+      mismatched = true;
+      mismatchStart = timestamp;
+    }
+    if (timestamp - mismatchStart >= parameters.holdTime) {
+      slipping = true;
+    }
+  } else {
+    mismatched = false;
+    if (difference < threshold / 2) {
+      slipping = false;
+    }
+  }
+  return slipping;
+}
+bool SlipDetector::isSlipping() const { return slipping; }
+void SlipDetector::reset() {
+  initialized = false;
+  slipping = false;
+  mismatched = false;
+  wheelAcceleration = QAcceleration();
+  imuAcceleration = QAcceleration();
+}
+}  // namespace apollo
@@ -1,49 +1,587 @@
 #include "apollo/chassis/tankDrive.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+#include "apollo/util/math.hpp"
 #include "apollo/util/util.hpp"
+#include "pros/error.h"
 #include "pros/motors.hpp"
+#include "pros/rtos.hpp"
 
 namespace apollo {
+namespace {
+// Tracker ports follow the motor convention: a negative first port reverses
+// the sensor. Three encoder ports select {expander port, top, bottom}.
+pros::ADIEncoder makeEncoderTracker(const std::vector<int>& ports) {
+  if (ports.size() >= 3) {
+    return pros::ADIEncoder(
+        std::make_tuple(static_cast<std::uint8_t>(std::abs(ports[0])),
+                        util::convert_adi_port(std::abs(ports[1])),
+                        util::convert_adi_port(std::abs(ports[2]))),
+        util::isNegative(ports[0]));
+  }
+  return pros::ADIEncoder(util::convert_adi_port(std::abs(ports.at(0))),
+                          util::convert_adi_port(std::abs(ports.at(1))),
+                          util::isNegative(ports[0]));
+}
+}  // namespace
+
 Tank::Tank(std::vector<int> leftDriveMotorPorts,
            std::vector<int> rightDriveMotorPorts, int inertialSensorPort,
            double cartridgeRPM, double gearRatio, double wheelDiameter)
     : inertialSensor(inertialSensorPort) {
-  for (auto i : leftDriveMotorPorts) {
-    leftDriveMotors.push_back(pros::Motor(std::abs(i), util::isNegative(i)));
-  }
-  for (auto i : rightDriveMotorPorts) {
-    rightDriveMotors.push_back(pros::Motor(std::abs(i), util::isNegative(i)));
-  }
+  initializeDrive(leftDriveMotorPorts, rightDriveMotorPorts, cartridgeRPM,
+                  gearRatio, wheelDiameter);
   trackerType = tracker_motor_integrated;
-  chassisType = tank_drive;
-  drivetrainCartridgeRPMS = cartridgeRPM;
-  drivetrainGearRatio = gearRatio;
-  drivetrainWheelDiameter = wheelDiameter;
-  drivetrainWheelCircumference = drivetrainWheelCircumference * M_PI;
-  trackerTickPerInch = 0;
-  trackerTickPerRevolution = 0;
+  trackerTickPerRevolution = 360;
   trackerGearRatio = drivetrainGearRatio;
   trackerWheelDiameter = drivetrainWheelDiameter;
   trackerWheelCircumference = drivetrainWheelCircumference;
+  if (trackerWheelCircumference != 0) {
+    trackerTickPerInch = trackerTickPerRevolution /
+                         (trackerGearRatio * trackerWheelCircumference);
+  }
 }
 Tank::Tank(std::vector<int> leftDriveMotorPorts,
            std::vector<int> rightDriveMotorPorts, int inertialSensorPort,
            double cartridgeRPM, double gearRatio, double wheelDiameter,
            std::vector<int> leftEncoderTrackerPorts,
-           std::vector<int> rightEncoderTrackerPorts);
+           std::vector<int> rightEncoderTrackerPorts)
+    : inertialSensor(inertialSensorPort),
+      leftEncoderTracker(makeEncoderTracker(leftEncoderTrackerPorts)),
+      rightEncoderTracker(makeEncoderTracker(rightEncoderTrackerPorts)) {
+  initializeDrive(leftDriveMotorPorts, rightDriveMotorPorts, cartridgeRPM,
+                  gearRatio, wheelDiameter);
+  trackerType = tracker_encoder_wheel;
+  trackerTickPerRevolution = 360;
+}
 Tank::Tank(std::vector<int> leftDriveMotorPorts,
            std::vector<int> rightDriveMotorPorts, int inertialSensorPort,
            double cartridgeRPM, double gearRatio, double wheelDiameter,
            std::vector<int> leftEncoderTrackerPorts,
            std::vector<int> rightEncoderTrackerPorts,
-           std::vector<int> centerEncoderTrackerPorts);
+           std::vector<int> centerEncoderTrackerPorts)
+    : inertialSensor(inertialSensorPort),
+      leftEncoderTracker(makeEncoderTracker(leftEncoderTrackerPorts)),
+      rightEncoderTracker(makeEncoderTracker(rightEncoderTrackerPorts)),
+      centerEncoderTracker(makeEncoderTracker(centerEncoderTrackerPorts)) {
+  initializeDrive(leftDriveMotorPorts, rightDriveMotorPorts, cartridgeRPM,
+                  gearRatio, wheelDiameter);
+  trackerType = tracker_encoder_wheel;
+  trackerTickPerRevolution = 360;
+  centerTrackerEnabled = true;
+}
 Tank::Tank(std::vector<int> leftDriveMotorPorts,
            std::vector<int> rightDriveMotorPorts, int inertialSensorPort,
-           double cartridgeRPM, int leftRotationTrackerPorts,
-           int rightRotationTrackerPorts);
+           double cartridgeRPM, double gearRatio, double wheelDiameter,
+           int leftRotationTrackerPorts, int rightRotationTrackerPorts)
+    : inertialSensor(inertialSensorPort),
+      leftRotationTracker(std::abs(leftRotationTrackerPorts),
+                          util::isNegative(leftRotationTrackerPorts)),
+      rightRotationTracker(std::abs(rightRotationTrackerPorts),
+                           util::isNegative(rightRotationTrackerPorts)) {
+  initializeDrive(leftDriveMotorPorts, rightDriveMotorPorts, cartridgeRPM,
+                  gearRatio, wheelDiameter);
+  trackerType = tracker_rotation_wheel;
+  trackerTickPerRevolution = 36000;
+}
 Tank::Tank(std::vector<int> leftDriveMotorPorts,
            std::vector<int> rightDriveMotorPorts, int inertialSensorPort,
-           double cartridgeRPM, int leftRotationTrackerPorts,
-           int rightRotationTrackerPorts, int centerRotationTrackerPorts);
+           double cartridgeRPM, double gearRatio, double wheelDiameter,
+           int leftRotationTrackerPorts, int rightRotationTrackerPorts,
+           int centerRotationTrackerPorts)
+    : inertialSensor(inertialSensorPort),
+      leftRotationTracker(std::abs(leftRotationTrackerPorts),
+                          util::isNegative(leftRotationTrackerPorts)),
+      rightRotationTracker(std::abs(rightRotationTrackerPorts),
+                           util::isNegative(rightRotationTrackerPorts)),
+      centerRotationTracker(std::abs(centerRotationTrackerPorts),
+                            util::isNegative(centerRotationTrackerPorts)) {
+  initializeDrive(leftDriveMotorPorts, rightDriveMotorPorts, cartridgeRPM,
+                  gearRatio, wheelDiameter);
+  trackerType = tracker_rotation_wheel;
+  trackerTickPerRevolution = 36000;
+  centerTrackerEnabled = true;
+}
+
+void Tank::initializeDrive(std::vector<int> leftDriveMotorPorts,
+                           std::vector<int> rightDriveMotorPorts,
+                           double cartridgeRPM, double gearRatio,
+                           double wheelDiameter) {
+  leftDriveMotors = MotorGroup(leftDriveMotorPorts);
+  rightDriveMotors = MotorGroup(rightDriveMotorPorts);
+  leftDriveMotors.setEncoderUnits(E_MOTOR_ENCODER_DEGREES);
+  rightDriveMotors.setEncoderUnits(E_MOTOR_ENCODER_DEGREES);
+  chassisType = tank_drive;
+  drivetrainCartridgeRPMS = cartridgeRPM;
+  drivetrainGearRatio = gearRatio;
+  drivetrainWheelDiameter = wheelDiameter;
+  drivetrainWheelCircumference = drivetrainWheelDiameter * M_PI;
+  trackerTickPerInch = 0;
+  trackerTickPerRevolution = 0;
+  trackerGearRatio = 1;
+  trackerWheelDiameter = 0;
+  trackerWheelCircumference = 0;
+  maxVelocity = drivetrainCartridgeRPMS * drivetrainGearRatio;
+}
+
+void Tank::update() {
+  if (sensorResetRequested) {
+    applySensorReset();
+  }
+  sampleSensors();
+  updateOdometry();
+  Pose pose = odometry.getPose();
+  if (sensorFrame.gpsSampled) {
+    gpsCorrection.recordPose(pose);
+    gpsCorrection.addSample(sensorFrame.gps);
+  }
+  pose = gpsCorrection.apply(pose);
+  poseBuffer.publish(pose);
+  updateCurrentBudget();
+  runMotion(pose);
+}
+
+// Taring devices under a running odometry would look like a jump in
+// position, so the reset is applied from the control task.
+void Tank::resetSensors() { sensorResetRequested = true; }
+void Tank::applySensorReset() {
+  leftDriveMotors.tarePosition();
+  rightDriveMotors.tarePosition();
+  leftEncoderTracker.reset();
+  rightEncoderTracker.reset();
+  centerEncoderTracker.reset();
+  leftRotationTracker.reset_position();
+  rightRotationTracker.reset_position();
+  centerRotationTracker.reset_position();
+  inertialSensor.tare();
+  odometry.reset();
+  timestampAligner.reset();
+  headingFilterInitialized = false;
+  gpsCorrection.reset();
+  sensorResetRequested = false;
+}
+
+// Runs before the motion so this tick's voltages are applied under this
+// tick's limits.
+void Tank::updateCurrentBudget() {
+  if (tractionControlEnabled) {
+    bool slipping = slipDetector.update(
+        wheelSpeed((sensorFrame.leftVelocity() + sensorFrame.rightVelocity()) /
+                   2),
+        sensorFrame.forwardAcceleration, sensorFrame.timestamp);
+    currentBudget.setSlipping(leftBudgetGroup, slipping);
+    currentBudget.setSlipping(rightBudgetGroup, slipping);
+  }
+  if (currentBudgetEnabled) {
+    // The drive motors were read into the frame this tick already.
+    std::int32_t leftDraw = 0;
+    std::int32_t rightDraw = 0;
+    for (std::size_t i = 0; i < sensorFrame.leftMotorCount; i++) {
+      leftDraw += sensorFrame.leftMotors[i].current;
+    }
+    for (std::size_t i = 0; i < sensorFrame.rightMotorCount; i++) {
+      rightDraw += sensorFrame.rightMotors[i].current;
+    }
+    currentBudget.setCurrentDraw(leftBudgetGroup, leftDraw);
+    currentBudget.setCurrentDraw(rightBudgetGroup, rightDraw);
+    currentBudget.update();
+  }
+}
+
+// Returns whether a motion drove the chassis this tick.
+bool Tank::runMotion(const Pose& pose) {
+  DriveOutput output;
+  if (!motionCommands.run({sensorFrame, pose, trackerLeftDistance,
+                           trackerRightDistance,
+                           wheelSpeed(sensorFrame.leftVelocity()),
+                           wheelSpeed(sensorFrame.rightVelocity()),
+                           sensorFrame.timestamp},
+                          output)) {
+    return false;
+  }
+  leftDriveMotors.moveVoltage(output.left);
+  rightDriveMotors.moveVoltage(output.right);
+  return true;
+}
+
+MotionHandle Tank::startMotion(std::shared_ptr<Motion> motion) {
+  return motionCommands.start(std::move(motion));
+}
+void Tank::cancelMotion() { motionCommands.cancel(); }
+void Tank::beginChain(QSpeed handoffVelocity) {
+  motionCommands.beginChain(handoffVelocity);
+}
+void Tank::endChain() { motionCommands.endChain(); }
+
+QSpeed Tank::wheelSpeed(QAngularSpeed motorVelocity) const {
+  return (motorVelocity.convert(rpm) * drivetrainGearRatio *
+          drivetrainWheelCircumference / 60) *
+         inch / second;
+}
+
+MotionHandle Tank::setDrivePID(QLength targetDistance, QSpeed targetVelocity) {
+  return motionCommands.drive(targetDistance, targetVelocity, getSides());
+}
+MotionHandle Tank::setTurnPID(QAngle targetAngle,
+                              QAngularSpeed targetVelocity) {
+  return motionCommands.turn(targetAngle, targetVelocity, getSides());
+}
+MotionHandle Tank::setSwingPID(direction targetDirection, QAngle targetAngle,
+                               QAngularSpeed targetVelocity) {
+  return motionCommands.swing(targetDirection, targetAngle, targetVelocity,
+                              getSides());
+}
+MotionHandle Tank::followPath(std::vector<Waypoint> path, QLength lookahead,
+                              QSpeed targetVelocity) {
+  return motionCommands.followPath(std::move(path), lookahead, targetVelocity,
+                                   getSides());
+}
+MotionHandle Tank::followTrajectory(
+    std::shared_ptr<const TrajectorySource> trajectory) {
+  return motionCommands.followTrajectory(std::move(trajectory), getSides());
+}
+
+TrajectoryConstraints Tank::getTrajectoryConstraints(
+    QAcceleration maxAcceleration) const {
+  return {getTopSpeed(), maxAcceleration, getTrackWidth()};
+}
+
+QSpeed Tank::getTopSpeed() const {
+  return (maxVelocity * drivetrainWheelCircumference / 60) * inch / second;
+}
+QLength Tank::getTrackWidth() const {
+  Odometry::TrackerOffsets offsets = odometry.getOffsets();
+  return offsets.left + offsets.right;
+}
+SideModel Tank::getSides() const {
+  return {getTopSpeed(), getTrackWidth(), maxVoltage};
+}
+
+void Tank::setTank(controller_analog_e_t leftAxis,
+                   controller_analog_e_t rightAxis,
+                   controller_analog_e_t*) {
+  driveSides((*driveCurve)(readAxis(leftAxis)),
+             (*driveCurve)(readAxis(rightAxis)));
+}
+void Tank::setArcade(controller_analog_e_t leftAxis,
+                     controller_analog_e_t rightAxis,
+                     controller_analog_e_t*) {
+  double forward = (*driveCurve)(readAxis(leftAxis));
+  double turn = (*turnCurve)(readAxis(rightAxis));
+  driveSides(forward + turn, forward - turn);
+}
+void Tank::setDriveCurve(const DriveCurve& curve) { driveCurve = &curve; }
+void Tank::setTurnCurve(const DriveCurve& curve) { turnCurve = &curve; }
+void Tank::setDriverSlew(double maxChange) { driverSlew = maxChange; }
+std::int32_t Tank::readAxis(controller_analog_e_t axis) {
+  return pros::c::controller_get_analog(E_CONTROLLER_MASTER, axis);
+}
+double Tank::slewDriverOutput(double target, double& output) const {
+  output = math::slew(target, output, driverSlew);
+  return output;
+}
+// Sides are fractions of full power. Arcade can ask for more than full
+// power on one side, so both are scaled down together to keep the turn.
+void Tank::driveSides(double left, double right) {
+  double scale = 1 / std::fmax(1, std::fmax(std::fabs(left), std::fabs(right)));
+  leftDriveMotors.moveVoltage(
+      slewDriverOutput(left * scale, leftDriverOutput) * maxVoltage);
+  rightDriveMotors.moveVoltage(
+      slewDriverOutput(right * scale, rightDriverOutput) * maxVoltage);
+}
+
+void Tank::setBrakeMode(motor_brake_mode_e_t mode) {
+  leftDriveMotors.setBrakeMode(mode);
+  rightDriveMotors.setBrakeMode(mode);
+}
+void Tank::setGearing(double gearing) {
+  drivetrainGearRatio = gearing;
+  if (trackerType == tracker_motor_integrated) {
+    trackerGearRatio = gearing;
+    trackerTickPerInch = trackerTickPerRevolution /
+                         (trackerGearRatio * trackerWheelCircumference);
+  }
+}
+void Tank::setEncoderUnits(double units) {
+  trackerTickPerRevolution = units;
+  if (trackerWheelCircumference != 0) {
+    trackerTickPerInch = trackerTickPerRevolution /
+                         (trackerGearRatio * trackerWheelCircumference);
+  }
+}
+void Tank::setMaxVelocity(double velocity) { maxVelocity = velocity; }
+void Tank::setMaxVoltage(double voltage) { maxVoltage = voltage; }
+motor_brake_mode_e_t Tank::getBrakeMode() const {
+  return leftDriveMotors.getBrakeMode();
+}
+double Tank::getGearing() const { return drivetrainGearRatio; }
+double Tank::getEncoderUnits() const { return trackerTickPerRevolution; }
+double Tank::getMaxVelocity() const { return maxVelocity; }
+double Tank::getMaxVoltage() const { return maxVoltage; }
+
+void Tank::setDriveGains(PIDGains gains) {
+  motionCommands.setDriveGains(gains);
+}
+void Tank::setHeadingGains(PIDGains gains) {
+  motionCommands.setHeadingGains(gains);
+}
+void Tank::setTurnGains(PIDGains gains) { motionCommands.setTurnGains(gains); }
+void Tank::setSwingGains(PIDGains gains) {
+  motionCommands.setSwingGains(gains);
+}
+void Tank::setRamseteGains(double b, double zeta) {
+  motionCommands.setRamseteGains(b, zeta);
+}
+void Tank::setFeedforward(FeedforwardGains gains) {
+  motionCommands.setFeedforward(gains);
+}
+Feedforward Tank::getFeedforward() const {
+  return motionCommands.getFeedforward(getSides());
+}
+bool Tank::characterize(const CharacterizationSettings& settings,
+                        const char* logPrefix) {
+  auto sequence = std::make_shared<CharacterizationSequence>(settings);
+  MotionHandle handle = startMotion(sequence);
+  handle.waitUntilSettled();
+  if (handle.getExitReason() != exit_completed) {
+    return false;
+  }
+  // A missing SD card shouldn't cost the fit.
+  if (logPrefix) {
+    sequence->writeLogs(logPrefix);
+  }
+  FeedforwardGains gains;
+  if (!sequence->fit(gains)) {
+    return false;
+  }
+  setFeedforward(gains);
+  return true;
+}
+void Tank::setDriveExitConditions(const ExitConditions& conditions) {
+  motionCommands.setDriveExitConditions(conditions);
+}
+void Tank::setTurnExitConditions(const ExitConditions& conditions) {
+  motionCommands.setTurnExitConditions(conditions);
+}
+void Tank::setDriveConstraints(QAcceleration acceleration, QJerk jerk) {
+  motionCommands.setDriveConstraints(acceleration, jerk);
+}
+
+void Tank::sampleSensors() {
+  sensorFrame.timestamp = pros::micros() * microsecond;
+  sensorFrame.leftMotorCount =
+      std::min(leftDriveMotors.size(), SensorFrame::maxSideMotors);
+  for (std::size_t i = 0; i < sensorFrame.leftMotorCount; i++) {
+    sampleMotor(leftDriveMotors[i], sensorFrame.leftMotors[i]);
+  }
+  sensorFrame.rightMotorCount =
+      std::min(rightDriveMotors.size(), SensorFrame::maxSideMotors);
+  for (std::size_t i = 0; i < sensorFrame.rightMotorCount; i++) {
+    sampleMotor(rightDriveMotors[i], sensorFrame.rightMotors[i]);
+  }
+  sensorFrame.heading = inertialSensor.get_heading() * degree;
+  sensorFrame.rotation = inertialSensor.get_rotation() * degree;
+  sensorFrame.headingRate = inertialSensor.get_gyro_rate().z * degree / second;
+  if (tractionControlEnabled) {
+    // The IMU reports acceleration in g.
+    pros::c::imu_accel_s_t acceleration = inertialSensor.get_accel();
+    double forward = imuForwardAxis == imu_x || imuForwardAxis == imu_negative_x
+                         ? acceleration.x
+                         : acceleration.y;
+    if (imuForwardAxis == imu_negative_x || imuForwardAxis == imu_negative_y) {
+      forward *= -1;
+    }
+    sensorFrame.forwardAcceleration = forward * G;
+  }
+  if (trackerType == tracker_encoder_wheel) {
+    sensorFrame.leftTrackerCount = leftEncoderTracker.get_value();
+    sensorFrame.rightTrackerCount = rightEncoderTracker.get_value();
+    if (centerTrackerEnabled) {
+      sensorFrame.centerTrackerCount = centerEncoderTracker.get_value();
+    }
+  } else if (trackerType == tracker_rotation_wheel) {
+    sensorFrame.leftTrackerCount = leftRotationTracker.get_position();
+    sensorFrame.rightTrackerCount = rightRotationTracker.get_position();
+    if (centerTrackerEnabled) {
+      sensorFrame.centerTrackerCount = centerRotationTracker.get_position();
+    }
+  }
+  sensorFrame.gpsSampled = gpsSensor != nullptr;
+  if (sensorFrame.gpsSampled) {
+    pros::c::gps_status_s_t status = gpsSensor->get_status();
+    sensorFrame.gps.x = status.x * meter;
+    sensorFrame.gps.y = status.y * meter;
+    sensorFrame.gps.error = gpsSensor->get_error() * meter;
+    sensorFrame.gps.timestamp = sensorFrame.timestamp;
+  }
+}
+
+// A reading the motor failed to take (PROS_ERR / PROS_ERR_F, e.g. while it
+// is unplugged) keeps the previous sample, so odometry sees the wheel hold
+// still instead of jumping.
+void Tank::sampleMotor(const pros::Motor& motor, MotorSample& sample) {
+  double position = motor.get_position();
+  if (position != PROS_ERR_F) {
+    sample.position = position * degree;
+  }
+  double velocity = motor.get_actual_velocity();
+  if (velocity != PROS_ERR_F) {
+    sample.velocity = velocity * rpm;
+  }
+  std::int32_t current = motor.get_current_draw();
+  if (current != PROS_ERR) {
+    sample.current = current;
+  }
+  if (trackerType == tracker_motor_integrated) {
+    sampleRawPosition(motor, sample);
+  }
+}
+
+// Raw counts are 1800/900/300 per revolution for the 100/200/600 rpm
+// cartridges. Unlike get_position they ignore the motor's reversed flag.
+void Tank::sampleRawPosition(const pros::Motor& motor, MotorSample& sample) {
+  std::uint32_t timestamp = 0;
+  std::int32_t counts = motor.get_raw_position(&timestamp);
+  if (counts == PROS_ERR) {
+    return;
+  }
+  if (motor.is_reversed()) {
+    counts = -counts;
+  }
+  double countsPerRevolution = 180000 / drivetrainCartridgeRPMS;
+  sample.rawPosition = (counts / countsPerRevolution) * 360 * degree;
+  sample.rawTimestamp = timestamp * millisecond;
+}
+
+void Tank::updateOdometry() {
+  // Pose resets are handed over through a buffer so they are applied from
+  // the control task instead of racing the integration.
+  if (poseResetBuffer.getVersion() != poseResetVersion) {
+    poseResetVersion = poseResetBuffer.getVersion();
+    odometry.setPose(poseResetBuffer.read());
+    gpsCorrection.reset();
+  }
+  if (trackerTickPerInch == 0) {
+    return;
+  }
+  double leftCount = sensorFrame.leftTrackerCount;
+  double rightCount = sensorFrame.rightTrackerCount;
+  QTime timestamp = sensorFrame.timestamp;
+  if (trackerType == tracker_motor_integrated) {
+    TimestampAligner::AlignedSides sides =
+        timestampAligner.align(sensorFrame);
+    leftCount = sides.left.convert(degree);
+    rightCount = sides.right.convert(degree);
+    timestamp = sides.timestamp;
+  }
+  QLength left = (leftCount / trackerTickPerInch) * inch;
+  QLength right = (rightCount / trackerTickPerInch) * inch;
+  QLength center = (sensorFrame.centerTrackerCount / trackerTickPerInch) * inch;
+  trackerLeftDistance = left;
+  trackerRightDistance = right;
+  QAngle heading = fuseHeading(left, right, timestamp);
+  odometry.update(left, right, center, heading, timestamp);
+}
+
+QAngle Tank::fuseHeading(QLength left, QLength right, QTime timestamp) {
+  // The IMU reports clockwise positive angles and rates.
+  QAngle imuHeading =
+      TimestampAligner::alignRotation(sensorFrame, timestamp) * -1;
+  if (!headingFilterInitialized) {
+    headingFilter.reset(imuHeading);
+    headingFilterInitialized = true;
+  } else {
+    QTime deltaTime = timestamp - lastFusionTime;
+    headingFilter.predict(deltaTime);
+    headingFilter.updateHeading(imuHeading);
+    headingFilter.updateGyroRate(sensorFrame.headingRate * -1);
+    Odometry::TrackerOffsets offsets = odometry.getOffsets();
+    QLength trackWidth = offsets.left + offsets.right;
+    if (trackWidth > 0 * meter && deltaTime > 0 * second) {
+      QAngle wheelDelta =
+          (((right - lastFusionRight) - (left - lastFusionLeft)) / trackWidth) *
+          radian;
+      headingFilter.updateWheelRate(wheelDelta / deltaTime);
+    }
+  }
+  lastFusionLeft = left;
+  lastFusionRight = right;
+  lastFusionTime = timestamp;
+  return headingFilter.getHeading();
+}
 
-}  // namespace apollo
\ No newline at end of file
+const SensorFrame& Tank::getSensorFrame() const { return sensorFrame; }
+Pose Tank::getPose() const { return poseBuffer.read(); }
+void Tank::setPose(const Pose& pose) { poseResetBuffer.publish(pose); }
+void Tank::setTrackingOffsets(QLength left, QLength right, QLength center) {
+  odometry.setOffsets({left, right, center});
+}
+void Tank::setHeadingNoise(HeadingFilter::Noise noise) {
+  headingFilter.setNoise(noise);
+}
+void Tank::setGps(int gpsPort, QLength xOffset, QLength yOffset) {
+  gpsSensor = std::make_unique<pros::Gps>(gpsPort, xOffset.convert(meter),
+                                          yOffset.convert(meter));
+}
+void Tank::setGpsParameters(GpsCorrection::Parameters parameters) {
+  gpsCorrection.setParameters(parameters);
+}
+// The GPS heading is clockwise from the field's +y axis.
+void Tank::setPoseFromGps() {
+  if (!gpsSensor) {
+    return;
+  }
+  pros::c::gps_status_s_t status = gpsSensor->get_status();
+  setPose({status.x * meter, status.y * meter,
+           (90 - gpsSensor->get_heading()) * degree,
+           pros::micros() * microsecond});
+}
+void Tank::enableCurrentBudget(CurrentBudget::GroupLimits driveLimits,
+                               CurrentBudget::Parameters parameters) {
+  currentBudget.setParameters(parameters);
+  if (currentBudgetEnabled) {
+    currentBudget.setLimits(leftBudgetGroup, driveLimits);
+    currentBudget.setLimits(rightBudgetGroup, driveLimits);
+    return;
+  }
+  leftBudgetGroup = currentBudget.addGroup(leftDriveMotors, driveLimits);
+  rightBudgetGroup = currentBudget.addGroup(rightDriveMotors, driveLimits);
+  currentBudgetEnabled = true;
+}
+CurrentBudget& Tank::getCurrentBudget() { return currentBudget; }
+void Tank::enableTractionControl(imuAxis forwardAxis,
+                                 SlipDetector::Parameters parameters) {
+  tractionControlEnabled = false;
+  imuForwardAxis = forwardAxis;
+  slipDetector.setParameters(parameters);
+  slipDetector.reset();
+  // Slip is only acted on through the drive sides' budget limits.
+  if (!currentBudgetEnabled) {
+    enableCurrentBudget(CurrentBudget::GroupLimits());
+  }
+  tractionControlEnabled = true;
+}
+bool Tank::isSlipping() const { return slipDetector.isSlipping(); }
+void Tank::setTrackerWheel(QLength wheelDiameter, double gearRatio) {
+  trackerWheelDiameter = wheelDiameter.convert(inch);
+  trackerWheelCircumference = trackerWheelDiameter * M_PI;
+  trackerGearRatio = gearRatio;
+  trackerTickPerInch = trackerTickPerRevolution /
+                       (trackerGearRatio * trackerWheelCircumference);
+}
+
+void Tank::startTracking(ControlLoop::loopPeriod period) {
+  stopTracking();
+  controlLoop = std::make_unique<ControlLoop>(*this, period);
+  controlLoop->start();
+}
+void Tank::stopTracking() {
+  if (controlLoop) {
+    controlLoop->stop();
+    controlLoop.reset();
+  }
+}
+}  // namespace apollo
@@ -0,0 +1,68 @@
+#include "apollo/chassis/timestampAligner.hpp"
+
+namespace apollo {
+TimestampAligner::AlignedSides TimestampAligner::align(
+    const SensorFrame& frame) {
+  if (!initialized) {
+    previousLeft = frame.leftMotors;
+    previousRight = frame.rightMotors;
+    initialized = true;
+  }
+  QTime timestamp = frame.timestamp;
+  for (std::size_t i = 0; i < frame.leftMotorCount; i++) {
+    if (frame.leftMotors[i].rawTimestamp < timestamp) {
+      timestamp = frame.leftMotors[i].rawTimestamp;
+    }
+  }
+  for (std::size_t i = 0; i < frame.rightMotorCount; i++) {
+    if (frame.rightMotors[i].rawTimestamp < timestamp) {
+      timestamp = frame.rightMotors[i].rawTimestamp;
+    }
+  }
+  AlignedSides sides{
+      alignSide(previousLeft, frame.leftMotors, frame.leftMotorCount,
+                timestamp),
+      alignSide(previousRight, frame.rightMotors, frame.rightMotorCount,
+                timestamp),
+      timestamp};
+  previousLeft = frame.leftMotors;
+  previousRight = frame.rightMotors;
+  return sides;
+}
+void TimestampAligner::reset() { initialized = false; }
+
+QAngle TimestampAligner::alignRotation(const SensorFrame& frame,
+                                       QTime timestamp) {
+  if (timestamp >= frame.timestamp) {
+    return frame.rotation;
+  }
+  return frame.rotation - frame.headingRate * (frame.timestamp - timestamp);
+}
+
+QAngle TimestampAligner::resample(const MotorSample& previous,
+                                  const MotorSample& current,
+                                  QTime timestamp) {
+  QTime span = current.rawTimestamp - previous.rawTimestamp;
+  if (current.rawTimestamp <= timestamp || span <= 0 * second) {
+    return current.rawPosition;
+  }
+  if (timestamp <= previous.rawTimestamp) {
+    return previous.rawPosition;
+  }
+  double fraction = ((timestamp - previous.rawTimestamp) / span).getValue();
+  return previous.rawPosition +
+         (current.rawPosition - previous.rawPosition) * fraction;
+}
+QAngle TimestampAligner::alignSide(const Samples& previous,
+                                   const Samples& current, std::size_t count,
+                                   QTime timestamp) {
+  if (count == 0) {
+    return QAngle();
+  }
+  QAngle total;
+  for (std::size_t i = 0; i < count; i++) {
+    total += resample(previous[i], current[i], timestamp);
+  }
+  return total / static_cast<double>(count);
+}
+}  // namespace apollo
@@ -0,0 +1,38 @@
+#include "apollo/chassis/trackers.hpp"
+
+#include <cmath>
+#include <cstdlib>
+
+#include "apollo/util/util.hpp"
+
+namespace apollo {
+RotationTrackers::RotationTrackers(int leftPort, int rightPort,
+                                   int centerPort, QLength wheelDiameter,
+                                   Odometry::TrackerOffsets offsets)
+    : leftTracker(std::abs(leftPort), util::isNegative(leftPort)),
+      rightTracker(std::abs(rightPort), util::isNegative(rightPort)),
+      centerTracker(std::abs(centerPort), util::isNegative(centerPort)),
+      wheelCircumference(wheelDiameter * M_PI),
+      offsets(offsets) {}
+
+// Rotation sensors count centidegrees.
+void RotationTrackers::sample() {
+  readings.left = wheelCircumference * (leftTracker.get_position() / 36000.0);
+  readings.right =
+      wheelCircumference * (rightTracker.get_position() / 36000.0);
+  readings.center =
+      wheelCircumference * (centerTracker.get_position() / 36000.0);
+}
+void RotationTrackers::reset() {
+  leftTracker.reset_position();
+  rightTracker.reset_position();
+  centerTracker.reset_position();
+  readings = TrackerReadings();
+}
+Odometry::TrackerOffsets RotationTrackers::getOffsets() const {
+  return offsets;
+}
+TrackerReadings RotationTrackers::measure(const HolonomicSpeeds&) const {
+  return readings;
+}
+}  // namespace apollo
@@ -0,0 +1,21 @@
+#include "apollo/chassis/xDrive.hpp"
+
+#include <cmath>
+
+namespace apollo {
+// Each wheel sits at 45 degrees to the robot, so it turns at 1/sqrt(2) of
+// the speed the robot translates at.
+XDrive::XDrive(std::vector<int> frontLeftMotorPorts,
+               std::vector<int> frontRightMotorPorts,
+               std::vector<int> backLeftMotorPorts,
+               std::vector<int> backRightMotorPorts, int inertialSensorPort,
+               double cartridgeRPM, double gearRatio, double wheelDiameter,
+               QLength trackRadius)
+    : HolonomicDrive({frontLeftMotorPorts, frontRightMotorPorts,
+                      backLeftMotorPorts, backRightMotorPorts},
+                     inertialSensorPort, cartridgeRPM, gearRatio,
+                     wheelDiameter, {M_SQRT1_2, trackRadius}) {}
+void XDrive::setTrackRadius(QLength trackRadius) {
+  setKinematics({M_SQRT1_2, trackRadius});
+}
+}  // namespace apollo
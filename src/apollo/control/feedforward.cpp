@@ -0,0 +1,109 @@
+#include "apollo/control/feedforward.hpp"
+
+#include <array>
+#include <cstdio>
+#include <utility>
+
+namespace apollo {
+namespace {
+constexpr double restingVelocity = 0.01;  // m/s
+}  // namespace
+
+bool fitFeedforward(
+    const std::vector<std::vector<CharacterizationSample>>& runs,
+    FeedforwardGains& gains) {
+  // Normal equations of the three parameter model.
+  std::array<std::array<double, 3>, 3> normal{};
+  std::array<double, 3> target{};
+  std::size_t used = 0;
+  for (const std::vector<CharacterizationSample>& run : runs) {
+    for (std::size_t i = 2; i + 2 < run.size(); i++) {
+      auto velocityAt = [&run](std::size_t j) {
+        return (run[j + 1].position - run[j - 1].position).convert(meter) /
+               (run[j + 1].timestamp - run[j - 1].timestamp).convert(second);
+      };
+      double velocity = velocityAt(i);
+      if (std::fabs(velocity) < restingVelocity) {
+        continue;
+      }
+      double acceleration =
+          (velocityAt(i + 1) - velocityAt(i - 1)) /
+          (run[i + 1].timestamp - run[i - 1].timestamp).convert(second);
+      std::array<double, 3> row = {velocity > 0 ? 1.0 : -1.0, velocity,
+                                   acceleration};
+      for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+          normal[r][c] += row[r] * row[c];
+        }
+        target[r] += row[r] * run[i].voltage;
+      }
+      used++;
+    }
+  }
+  if (used < 3) {
+    return false;
+  }
+  // Gaussian elimination with partial pivoting.
+  for (int column = 0; column < 3; column++) {
+    int pivot = column;
+    for (int r = column + 1; r < 3; r++) {
+      if (std::fabs(normal[r][column]) > std::fabs(normal[pivot][column])) {
+        pivot = r;
+      }
+    }
+    std::swap(normal[column], normal[pivot]);
+    std::swap(target[column], target[pivot]);
+    if (std::fabs(normal[column][column]) < 1e-9) {
+      return false;
+    }
+    for (int r = column + 1; r < 3; r++) {
+      double factor = normal[r][column] / normal[column][column];
+      for (int c = column; c < 3; c++) {
+        normal[r][c] -= factor * normal[column][c];
+      }
+      target[r] -= factor * target[column];
+    }
+  }
+  std::array<double, 3> solution{};
+  for (int r = 2; r >= 0; r--) {
+    double sum = target[r];
+    for (int c = r + 1; c < 3; c++) {
+      sum -= normal[r][c] * solution[c];
+    }
+    solution[r] = sum / normal[r][r];
+  }
+  gains = {solution[0], solution[1], solution[2]};
+  return true;
+}
+
+bool writeCharacterizationLog(
+    const std::vector<CharacterizationSample>& samples, const char* path) {
+  std::FILE* file = std::fopen(path, "w");
+  if (!file) {
+    return false;
+  }
+  bool written = std::fputs("time,voltage,position\n", file) >= 0;
+  for (const CharacterizationSample& sample : samples) {
+    written = written &&
+              std::fprintf(file, "%.6f,%.1f,%.6f\n",
+                           sample.timestamp.convert(second), sample.voltage,
+                           sample.position.convert(meter)) > 0;
+  }
+  return std::fclose(file) == 0 && written;
+}
+bool readCharacterizationLog(const char* path,
+                             std::vector<CharacterizationSample>& samples) {
+  std::FILE* file = std::fopen(path, "r");
+  if (!file) {
+    return false;
+  }
+  samples.clear();
+  std::fscanf(file, "%*[^\n]\n");
+  double time, voltage, position;
+  while (std::fscanf(file, "%lf,%lf,%lf", &time, &voltage, &position) == 3) {
+    samples.push_back({time * second, voltage, position * meter});
+  }
+  std::fclose(file);
+  return !samples.empty();
+}
+}  // namespace apollo
@@ -0,0 +1,150 @@
+#include "apollo/control/motionProfile.hpp"
+
+#include <cmath>
+
+namespace apollo {
+MotionProfile::MotionProfile(QLength distance, ProfileConstraints constraints,
+                             QSpeed startVelocity, QSpeed endVelocity)
+    : distance(distance), constraints(constraints) {
+  double length = std::fabs(distance.convert(meter));
+  direction = distance < 0 * meter ? -1 : 1;
+  double maxVelocity = std::fabs(constraints.maxVelocity.convert(mps));
+  if (length == 0 || maxVelocity == 0 ||
+      constraints.maxAcceleration <= 0 * mps2) {
+    return;
+  }
+  // Speeds along the move; moving against it counts as starting at rest.
+  double from = std::fmin(
+      std::fmax(direction * startVelocity.convert(mps), 0), maxVelocity);
+  double to = std::fmin(std::fmax(direction * endVelocity.convert(mps), 0),
+                        maxVelocity);
+  if (changeDistance(from, to) > length) {
+    // Too short to reach the end speed: end at the closest one a single
+    // ramp from the start speed can reach.
+    double low = std::fmin(from, to);
+    double high = std::fmax(from, to);
+    for (int i = 0; i < 60; i++) {
+      double middle = (low + high) / 2;
+      bool fits = changeDistance(from, middle) <= length;
+      (fits == (to > from) ? low : high) = middle;
+    }
+    to = to > from ? low : high;
+  }
+  startSpeed = from;
+  endSpeed = to;
+  double peakVelocity = maxVelocity;
+  auto rampDistance = [this, from, to](double peak) {
+    return changeDistance(from, peak) + changeDistance(peak, to);
+  };
+  if (rampDistance(maxVelocity) > length) {
+    // No room to cruise: find the peak whose ramps cover the distance.
+    double low = std::fmax(from, to);
+    double high = maxVelocity;
+    for (int i = 0; i < 60; i++) {
+      double middle = (low + high) / 2;
+      (rampDistance(middle) > length ? high : low) = middle;
+    }
+    peakVelocity = low;
+  }
+  addVelocityChange(from, peakVelocity);
+  double cruise = length - rampDistance(peakVelocity);
+  if (cruise > 0 && peakVelocity > 0) {
+    addSegment(cruise / peakVelocity, 0, 0);
+  }
+  addVelocityChange(peakVelocity, to);
+}
+
+// Distance covered while changing speed. Each ramp is symmetric, so the
+// average speed over it is the mean of its end speeds.
+double MotionProfile::changeDistance(double fromVelocity,
+                                     double toVelocity) const {
+  double change = std::fabs(toVelocity - fromVelocity);
+  double acceleration = constraints.maxAcceleration.getValue();
+  double jerk = constraints.maxJerk.getValue();
+  double time = change / acceleration;
+  if (jerk > 0) {
+    time = change * jerk >= acceleration * acceleration
+               ? change / acceleration + acceleration / jerk
+               : 2 * std::sqrt(change / jerk);
+  }
+  return (fromVelocity + toVelocity) / 2 * time;
+}
+
+void MotionProfile::addVelocityChange(double fromVelocity,
+                                      double toVelocity) {
+  double change = std::fabs(toVelocity - fromVelocity);
+  double sign = toVelocity > fromVelocity ? 1 : -1;
+  double acceleration = constraints.maxAcceleration.getValue();
+  double jerk = constraints.maxJerk.getValue();
+  if (change == 0) {
+    return;
+  }
+  if (jerk <= 0) {
+    addSegment(change / acceleration, sign * acceleration, 0);
+  } else if (change * jerk >= acceleration * acceleration) {
+    double jerkTime = acceleration / jerk;
+    addSegment(jerkTime, 0, sign * jerk);
+    addSegment(change / acceleration - jerkTime, sign * acceleration, 0);
+    addSegment(jerkTime, sign * acceleration, -sign * jerk);
+  } else {
+    double jerkTime = std::sqrt(change / jerk);
+    addSegment(jerkTime, 0, sign * jerk);
+    addSegment(jerkTime, sign * jerk * jerkTime, -sign * jerk);
+  }
+}
+
+void MotionProfile::addSegment(double duration, double acceleration,
+                               double jerk) {
+  Segment segment;
+  segment.velocity = startSpeed;
+  if (segmentCount > 0) {
+    const Segment& last = segments[segmentCount - 1];
+    double t = last.duration;
+    segment.startTime = last.startTime + t;
+    segment.position = last.position + last.velocity * t +
+                       last.acceleration * t * t / 2 +
+                       last.jerk * t * t * t / 6;
+    segment.velocity =
+        last.velocity + last.acceleration * t + last.jerk * t * t / 2;
+  }
+  segment.duration = duration;
+  segment.acceleration = acceleration;
+  segment.jerk = jerk;
+  segments[segmentCount++] = segment;
+  this->duration = segment.startTime + duration;
+}
+
+ProfileSetpoint MotionProfile::sample(QTime time) const {
+  // Without limits to plan against the profile is a step to the target.
+  double t = time.convert(second);
+  if (segmentCount == 0 || t >= duration) {
+    return {distance, direction * endSpeed * mps, QAcceleration(), QJerk()};
+  }
+  std::size_t index = 0;
+  while (index + 1 < segmentCount && t >= segments[index + 1].startTime) {
+    index++;
+  }
+  const Segment& segment = segments[index];
+  double dt = std::fmax(t - segment.startTime, 0);
+  double position = segment.position + segment.velocity * dt +
+                    segment.acceleration * dt * dt / 2 +
+                    segment.jerk * dt * dt * dt / 6;
+  double velocity = segment.velocity + segment.acceleration * dt +
+                    segment.jerk * dt * dt / 2;
+  double acceleration = segment.acceleration + segment.jerk * dt;
+  return {direction * position * meter, direction * velocity * mps,
+          direction * acceleration * mps2, QJerk(direction * segment.jerk)};
+}
+
+QTime MotionProfile::getDuration() const { return duration * second; }
+QLength MotionProfile::getDistance() const { return distance; }
+QSpeed MotionProfile::getStartVelocity() const {
+  return direction * startSpeed * mps;
+}
+QSpeed MotionProfile::getEndVelocity() const {
+  return direction * endSpeed * mps;
+}
+const ProfileConstraints& MotionProfile::getConstraints() const {
+  return constraints;
+}
+}  // namespace apollo
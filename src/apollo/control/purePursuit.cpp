@@ -0,0 +1,171 @@
+#include "apollo/control/purePursuit.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace apollo {
+PurePursuit::PurePursuit(std::vector<Waypoint> path, QLength lookahead)
+    : lookahead(lookahead.convert(meter)) {
+  pathX.reserve(path.size());
+  pathY.reserve(path.size());
+  pathDistance.reserve(path.size());
+  for (const Waypoint& waypoint : path) {
+    double x = waypoint.x.convert(meter);
+    double y = waypoint.y.convert(meter);
+    pathDistance.push_back(
+        pathX.empty() ? 0
+                      : pathDistance.back() +
+                            std::hypot(x - pathX.back(), y - pathY.back()));
+    pathX.push_back(x);
+    pathY.push_back(y);
+  }
+  reset();
+}
+
+void PurePursuit::reset() {
+  closestSegment = 0;
+  closestFraction = 0;
+  lookaheadSegment = 0;
+  lookaheadFraction = 0;
+  lookaheadX = pathX.empty() ? 0 : pathX.front();
+  lookaheadY = pathY.empty() ? 0 : pathY.front();
+}
+
+double PurePursuit::update(const Pose& pose) {
+  if (pathX.empty()) {
+    return 0;
+  }
+  double x = pose.x.convert(meter);
+  double y = pose.y.convert(meter);
+  updateClosest(x, y);
+  updateLookahead(x, y);
+  // Lateral offset of the lookahead point in the robot's frame.
+  double theta = pose.theta.convert(radian);
+  double dx = lookaheadX - x;
+  double dy = lookaheadY - y;
+  double lateral = -std::sin(theta) * dx + std::cos(theta) * dy;
+  double distanceSquared = dx * dx + dy * dy;
+  if (distanceSquared < 1e-9) {
+    return 0;
+  }
+  return 2 * lateral / distanceSquared;
+}
+
+void PurePursuit::updateClosest(double x, double y) {
+  std::size_t last = pathX.size() - 1;
+  double windowEnd = getTravelled().convert(meter) + lookahead;
+  double best = INFINITY;
+  for (std::size_t i = closestSegment; i < last && pathDistance[i] <= windowEnd;
+       i++) {
+    double segmentX = pathX[i + 1] - pathX[i];
+    double segmentY = pathY[i + 1] - pathY[i];
+    double lengthSquared = segmentX * segmentX + segmentY * segmentY;
+    double fraction =
+        lengthSquared == 0
+            ? 0
+            : ((x - pathX[i]) * segmentX + (y - pathY[i]) * segmentY) /
+                  lengthSquared;
+    fraction = std::clamp(fraction, i == closestSegment ? closestFraction : 0,
+                          1.0);
+    double distance = std::hypot(pathX[i] + fraction * segmentX - x,
+                                 pathY[i] + fraction * segmentY - y);
+    if (distance < best) {
+      best = distance;
+      closestSegment = i;
+      closestFraction = fraction;
+    }
+  }
+}
+
+// Takes the furthest intersection of the lookahead circle with the path,
+// up to one lookahead distance along the path past the closest point.
+// Without one, e.g. while the robot is off the path by more than the
+// lookahead, the end of that window is used so the robot is still pulled
+// forwards onto the path rather than back to an old point.
+void PurePursuit::updateLookahead(double x, double y) {
+  std::size_t last = pathX.size() - 1;
+  if (last == 0 ||
+      std::hypot(pathX[last] - x, pathY[last] - y) <= lookahead) {
+    setLookahead(last, 0);
+    return;
+  }
+  if (lookaheadSegment < closestSegment ||
+      (lookaheadSegment == closestSegment &&
+       lookaheadFraction < closestFraction)) {
+    setLookahead(closestSegment, closestFraction);
+  }
+  double windowEnd =
+      std::min(getTravelled().convert(meter) + lookahead, pathDistance[last]);
+  bool found = false;
+  for (std::size_t i = lookaheadSegment;
+       i < last && pathDistance[i] <= windowEnd; i++) {
+    double segmentX = pathX[i + 1] - pathX[i];
+    double segmentY = pathY[i + 1] - pathY[i];
+    double offsetX = pathX[i] - x;
+    double offsetY = pathY[i] - y;
+    double a = segmentX * segmentX + segmentY * segmentY;
+    double b = 2 * (offsetX * segmentX + offsetY * segmentY);
+    double c = offsetX * offsetX + offsetY * offsetY - lookahead * lookahead;
+    double discriminant = b * b - 4 * a * c;
+    if (a == 0 || discriminant < 0) {
+      continue;
+    }
+    double fraction = (-b + std::sqrt(discriminant)) / (2 * a);
+    if (fraction < 0 || fraction > 1 ||
+        (i == lookaheadSegment && fraction < lookaheadFraction)) {
+      continue;
+    }
+    setLookahead(i, fraction);
+    found = true;
+  }
+  if (found) {
+    return;
+  }
+  std::size_t segment = lookaheadSegment;
+  while (segment + 1 < last && pathDistance[segment + 1] < windowEnd) {
+    segment++;
+  }
+  double length = pathDistance[segment + 1] - pathDistance[segment];
+  double fraction =
+      length == 0 ? 1 : (windowEnd - pathDistance[segment]) / length;
+  if (segment > lookaheadSegment || fraction > lookaheadFraction) {
+    setLookahead(segment, std::min(fraction, 1.0));
+  }
+}
+void PurePursuit::setLookahead(std::size_t segment, double fraction) {
+  lookaheadSegment = segment;
+  lookaheadFraction = fraction;
+  if (segment + 1 >= pathX.size()) {
+    lookaheadX = pathX[segment];
+    lookaheadY = pathY[segment];
+    return;
+  }
+  lookaheadX =
+      pathX[segment] + fraction * (pathX[segment + 1] - pathX[segment]);
+  lookaheadY =
+      pathY[segment] + fraction * (pathY[segment + 1] - pathY[segment]);
+}
+
+Waypoint PurePursuit::getLookaheadPoint() const {
+  return {lookaheadX * meter, lookaheadY * meter};
+}
+std::size_t PurePursuit::getClosestIndex() const { return closestSegment; }
+QLength PurePursuit::getTravelled() const {
+  if (pathX.empty() || closestSegment + 1 >= pathX.size()) {
+    return getLength();
+  }
+  return (pathDistance[closestSegment] +
+          closestFraction * (pathDistance[closestSegment + 1] -
+                             pathDistance[closestSegment])) *
+         meter;
+}
+QLength PurePursuit::getRemaining() const {
+  return getLength() - getTravelled();
+}
+QLength PurePursuit::getLength() const {
+  return (pathDistance.empty() ? 0 : pathDistance.back()) * meter;
+}
+bool PurePursuit::isAtEnd() const {
+  return !pathX.empty() && lookaheadSegment == pathX.size() - 1;
+}
+}  // namespace apollo
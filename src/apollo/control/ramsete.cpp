@@ -0,0 +1,47 @@
+#include "apollo/control/ramsete.hpp"
+
+#include <cmath>
+
+namespace apollo {
+RamseteController::RamseteController(double b, double zeta)
+    : b(b), zeta(zeta) {}
+void RamseteController::setGains(double b, double zeta) {
+  this->b = b;
+  this->zeta = zeta;
+}
+
+ChassisSpeeds RamseteController::step(
+    const Pose& pose, const TrajectoryPoint& reference) const {
+  QLength dx = reference.pose.x - pose.x;
+  QLength dy = reference.pose.y - pose.y;
+  // Error in the robot's frame.
+  QLength errorX = cos(pose.theta) * dx + sin(pose.theta) * dy;
+  QLength errorY = cos(pose.theta) * dy - sin(pose.theta) * dx;
+  QAngle errorTheta = reference.pose.theta - pose.theta;
+  errorTheta -= round(errorTheta, 2 * M_PI * radian);
+  QSpeed velocity = reference.velocity;
+  QAngularSpeed angularVelocity = reference.angularVelocity;
+  // b and zeta are plain tuning numbers, so the units are fixed at the
+  // gain: k is computed from the converted speeds and taken as a rate, and
+  // b turns m^2/s of cross-track error into rad/s.
+  QFrequency gain = 2 * zeta *
+                    std::sqrt(std::pow(angularVelocity.convert(radps), 2) +
+                              b * std::pow(velocity.convert(mps), 2)) *
+                    Hz;
+  Number sinc = abs(errorTheta) < 1e-6 * radian
+                    ? number - square(errorTheta / radian) / 6
+                    : sin(errorTheta) / (errorTheta / radian);
+  QAngularSpeed crossTrack =
+      b * sinc * velocity * errorY * radian / (meter * meter);
+  return {velocity * cos(errorTheta) + gain * errorX,
+          angularVelocity + gain * errorTheta + crossTrack};
+}
+
+WheelVelocities RamseteController::step(const Pose& pose,
+                                        const TrajectoryPoint& reference,
+                                        QLength trackWidth) const {
+  ChassisSpeeds speeds = step(pose, reference);
+  QSpeed turn = speeds.angular * (trackWidth / 2) / radian;
+  return {speeds.linear - turn, speeds.linear + turn};
+}
+}  // namespace apollo
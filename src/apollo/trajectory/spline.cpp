@@ -0,0 +1,81 @@
+#include "apollo/trajectory/spline.hpp"
+
+#include <cmath>
+
+namespace apollo {
+namespace {
+// Power basis coefficients of a quintic Hermite curve from the end
+// positions p, first derivatives v and second derivatives a.
+std::array<double, 6> hermiteCoefficients(double p0, double v0, double a0,
+                                          double p1, double v1, double a1) {
+  return {p0,
+          v0,
+          a0 / 2,
+          -10 * p0 - 6 * v0 - 1.5 * a0 + 0.5 * a1 - 4 * v1 + 10 * p1,
+          15 * p0 + 8 * v0 + 1.5 * a0 - a1 + 7 * v1 - 15 * p1,
+          -6 * p0 - 3 * v0 - 0.5 * a0 + 0.5 * a1 - 3 * v1 + 6 * p1};
+}
+double evaluate(const std::array<double, 6>& c, double t) {
+  return ((((c[5] * t + c[4]) * t + c[3]) * t + c[2]) * t + c[1]) * t + c[0];
+}
+double evaluateDerivative(const std::array<double, 6>& c, double t) {
+  return (((5 * c[5] * t + 4 * c[4]) * t + 3 * c[3]) * t + 2 * c[2]) * t +
+         c[1];
+}
+double evaluateSecondDerivative(const std::array<double, 6>& c, double t) {
+  return ((20 * c[5] * t + 12 * c[4]) * t + 6 * c[3]) * t + 2 * c[2];
+}
+}  // namespace
+
+QuinticSpline::QuinticSpline(const SplinePoint& start,
+                             const SplinePoint& end) {
+  double x0 = start.x.convert(meter);
+  double y0 = start.y.convert(meter);
+  double x1 = end.x.convert(meter);
+  double y1 = end.y.convert(meter);
+  double chord = std::hypot(x1 - x0, y1 - y0);
+  double startScale = chord * start.tangentScale;
+  double endScale = chord * end.tangentScale;
+  double startHeading = start.heading.convert(radian);
+  double endHeading = end.heading.convert(radian);
+  xCoefficients =
+      hermiteCoefficients(x0, startScale * std::cos(startHeading), 0, x1,
+                          endScale * std::cos(endHeading), 0);
+  yCoefficients =
+      hermiteCoefficients(y0, startScale * std::sin(startHeading), 0, y1,
+                          endScale * std::sin(endHeading), 0);
+}
+
+void QuinticSpline::position(double t, double& x, double& y) const {
+  x = evaluate(xCoefficients, t);
+  y = evaluate(yCoefficients, t);
+}
+void QuinticSpline::derivative(double t, double& x, double& y) const {
+  x = evaluateDerivative(xCoefficients, t);
+  y = evaluateDerivative(yCoefficients, t);
+}
+void QuinticSpline::secondDerivative(double t, double& x, double& y) const {
+  x = evaluateSecondDerivative(xCoefficients, t);
+  y = evaluateSecondDerivative(yCoefficients, t);
+}
+double QuinticSpline::curvature(double t) const {
+  double dx, dy, ddx, ddy;
+  derivative(t, dx, dy);
+  secondDerivative(t, ddx, ddy);
+  double speed = std::hypot(dx, dy);
+  if (speed < 1e-9) {
+    return 0;
+  }
+  return (dx * ddy - dy * ddx) / (speed * speed * speed);
+}
+
+SplinePath::SplinePath(const std::vector<SplinePoint>& points) {
+  for (std::size_t i = 1; i < points.size(); i++) {
+    splines.emplace_back(points[i - 1], points[i]);
+  }
+}
+const QuinticSpline& SplinePath::operator[](std::size_t index) const {
+  return splines[index];
+}
+std::size_t SplinePath::size() const { return splines.size(); }
+}  // namespace apollo
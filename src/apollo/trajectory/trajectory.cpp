@@ -0,0 +1,154 @@
+#include "apollo/trajectory/trajectory.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace apollo {
+TrajectoryPoint interpolate(const TrajectoryPoint& start,
+                            const TrajectoryPoint& end, QTime time) {
+  double fraction = ((time - start.pose.timestamp) /
+                     (end.pose.timestamp - start.pose.timestamp))
+                        .getValue();
+  auto lerp = [fraction](auto a, auto b) { return a + (b - a) * fraction; };
+  TrajectoryPoint point;
+  point.pose = {lerp(start.pose.x, end.pose.x), lerp(start.pose.y, end.pose.y),
+                lerp(start.pose.theta, end.pose.theta), time};
+  point.distance = lerp(start.distance, end.distance);
+  point.velocity = lerp(start.velocity, end.velocity);
+  point.acceleration = end.acceleration;
+  point.angularVelocity = lerp(start.angularVelocity, end.angularVelocity);
+  point.curvature = lerp(start.curvature, end.curvature);
+  point.leftVelocity = lerp(start.leftVelocity, end.leftVelocity);
+  point.rightVelocity = lerp(start.rightVelocity, end.rightVelocity);
+  return point;
+}
+
+Trajectory::Trajectory(std::vector<TrajectoryPoint> points)
+    : points(std::move(points)) {}
+
+TrajectoryPoint Trajectory::sample(QTime time) const {
+  if (points.empty()) {
+    return TrajectoryPoint();
+  }
+  if (time <= points.front().pose.timestamp) {
+    return points.front();
+  }
+  if (time >= points.back().pose.timestamp) {
+    return points.back();
+  }
+  auto after = std::upper_bound(
+      points.begin(), points.end(), time,
+      [](QTime time, const TrajectoryPoint& point) {
+        return time < point.pose.timestamp;
+      });
+  return interpolate(*(after - 1), *after, time);
+}
+
+QTime Trajectory::getDuration() const {
+  return points.empty() ? QTime() : points.back().pose.timestamp;
+}
+QLength Trajectory::getLength() const {
+  return points.empty() ? QLength() : points.back().distance;
+}
+const TrajectoryPoint& Trajectory::operator[](std::size_t index) const {
+  return points[index];
+}
+std::size_t Trajectory::size() const { return points.size(); }
+bool Trajectory::empty() const { return points.empty(); }
+
+TrajectoryGenerator::TrajectoryGenerator(TrajectoryConstraints constraints,
+                                         QLength spacing)
+    : constraints(constraints), spacing(spacing) {}
+
+Trajectory TrajectoryGenerator::generate(const SplinePath& path) const {
+  double step = spacing.convert(meter);
+  double maxVelocity = constraints.maxVelocity.convert(mps);
+  double maxAcceleration = constraints.maxAcceleration.convert(mps2);
+  double halfTrack = constraints.trackWidth.convert(meter) / 2;
+  if (path.size() == 0 || step <= 0 || maxVelocity <= 0 ||
+      maxAcceleration <= 0) {
+    return Trajectory();
+  }
+
+  // Walk each spline in parameter steps of roughly one spacing of arc
+  // length, using the local speed of the parameterization.
+  std::vector<double> x, y, theta, curvature, distance;
+  auto addPoint = [&](const QuinticSpline& spline, double t) {
+    double px, py, dx, dy;
+    spline.position(t, px, py);
+    spline.derivative(t, dx, dy);
+    double heading = std::atan2(dy, dx);
+    if (!theta.empty()) {
+      // Keep the heading continuous like the odometry's.
+      heading = theta.back() +
+                std::remainder(heading - theta.back(), 2 * M_PI);
+    }
+    distance.push_back(distance.empty() ? 0
+                                        : distance.back() +
+                                              std::hypot(px - x.back(),
+                                                         py - y.back()));
+    x.push_back(px);
+    y.push_back(py);
+    theta.push_back(heading);
+    curvature.push_back(spline.curvature(t));
+  };
+  for (std::size_t i = 0; i < path.size(); i++) {
+    const QuinticSpline& spline = path[i];
+    if (i == 0) {
+      addPoint(spline, 0);
+    }
+    double t = 0;
+    while (t < 1) {
+      double dx, dy;
+      spline.derivative(t, dx, dy);
+      double speed = std::hypot(dx, dy);
+      t = speed < 1e-9 ? 1 : std::min(1.0, t + step / speed);
+      addPoint(spline, t);
+    }
+  }
+
+  std::size_t count = x.size();
+  std::vector<double> velocity(count);
+  for (std::size_t i = 0; i < count; i++) {
+    velocity[i] = maxVelocity / (1 + std::fabs(curvature[i]) * halfTrack);
+  }
+  velocity.front() = 0;
+  velocity.back() = 0;
+  for (std::size_t i = 1; i < count; i++) {
+    double ds = distance[i] - distance[i - 1];
+    velocity[i] =
+        std::min(velocity[i], std::sqrt(velocity[i - 1] * velocity[i - 1] +
+                                        2 * maxAcceleration * ds));
+  }
+  for (std::size_t i = count - 1; i > 0; i--) {
+    double ds = distance[i] - distance[i - 1];
+    velocity[i - 1] =
+        std::min(velocity[i - 1], std::sqrt(velocity[i] * velocity[i] +
+                                            2 * maxAcceleration * ds));
+  }
+
+  std::vector<TrajectoryPoint> points(count);
+  double time = 0;
+  for (std::size_t i = 0; i < count; i++) {
+    double acceleration = 0;
+    if (i > 0) {
+      double ds = distance[i] - distance[i - 1];
+      double averageVelocity = (velocity[i] + velocity[i - 1]) / 2;
+      double dt = averageVelocity > 0 ? ds / averageVelocity : 0;
+      time += dt;
+      acceleration = dt > 0 ? (velocity[i] - velocity[i - 1]) / dt : 0;
+    }
+    TrajectoryPoint& point = points[i];
+    point.pose = {x[i] * meter, y[i] * meter, theta[i] * radian,
+                  time * second};
+    point.distance = distance[i] * meter;
+    point.velocity = velocity[i] * mps;
+    point.acceleration = acceleration * mps2;
+    point.angularVelocity = velocity[i] * curvature[i] * radps;
+    point.curvature = curvature[i];
+    point.leftVelocity = velocity[i] * (1 - curvature[i] * halfTrack) * mps;
+    point.rightVelocity = velocity[i] * (1 + curvature[i] * halfTrack) * mps;
+  }
+  return Trajectory(std::move(points));
+}
+}  // namespace apollo
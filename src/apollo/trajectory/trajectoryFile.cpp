@@ -0,0 +1,320 @@
+#include "apollo/trajectory/trajectoryFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace apollo {
+namespace {
+using namespace trajectoryFile;
+
+void putU16(std::uint8_t* bytes, std::uint16_t value) {
+  bytes[0] = value & 0xFF;
+  bytes[1] = value >> 8;
+}
+void putU32(std::uint8_t* bytes, std::uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    bytes[i] = (value >> (8 * i)) & 0xFF;
+  }
+}
+void putFloat(std::uint8_t* bytes, float value) {
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  putU32(bytes, bits);
+}
+std::uint16_t getU16(const std::uint8_t* bytes) {
+  return bytes[0] | (bytes[1] << 8);
+}
+std::uint32_t getU32(const std::uint8_t* bytes) {
+  std::uint32_t value = 0;
+  for (int i = 0; i < 4; i++) {
+    value |= std::uint32_t(bytes[i]) << (8 * i);
+  }
+  return value;
+}
+float getFloat(const std::uint8_t* bytes) {
+  std::uint32_t bits = getU32(bytes);
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+std::size_t chunkCount(std::uint32_t points, std::uint32_t chunkSize) {
+  if (points <= 1) {
+    return points;
+  }
+  return (points - 2) / (chunkSize - 1) + 1;
+}
+// Size a file with this header must have, in 64 bits so that a corrupt
+// point count or chunk size can't wrap it into a plausible value.
+std::uint64_t fileSize(std::uint32_t points, std::uint32_t chunkSize) {
+  std::uint64_t chunks = chunkCount(points, chunkSize);
+  return headerSize + 4 * chunks +
+         chunks * chunkSize * std::uint64_t(fieldCount) * 4;
+}
+std::size_t chunkOffset(std::size_t chunk, std::size_t chunks,
+                        std::uint32_t chunkSize) {
+  return headerSize + 4 * chunks + chunk * chunkSize * fieldCount * 4;
+}
+}  // namespace
+
+TrajectoryWriter::TrajectoryWriter(std::uint32_t chunkSize)
+    : chunkSize(std::clamp<std::uint32_t>(chunkSize, 2, maxChunkSize)) {}
+
+bool TrajectoryWriter::write(const Trajectory& trajectory, QLength trackWidth,
+                             const char* path) const {
+  std::FILE* file = std::fopen(path, "wb");
+  if (!file) {
+    return false;
+  }
+  std::uint32_t points = trajectory.size();
+  std::size_t chunks = chunkCount(points, chunkSize);
+  std::vector<std::uint8_t> buffer(headerSize + 4 * chunks);
+  putU32(&buffer[0], magic);
+  putU16(&buffer[4], version);
+  putU16(&buffer[6], fieldCount);
+  putU32(&buffer[8], points);
+  putU32(&buffer[12], chunkSize);
+  putFloat(&buffer[16], trajectory.getDuration().convert(second));
+  putFloat(&buffer[20], trajectory.getLength().convert(meter));
+  putFloat(&buffer[24], trackWidth.convert(meter));
+  for (std::size_t i = 0; i < chunks; i++) {
+    putFloat(&buffer[headerSize + 4 * i],
+             trajectory[i * (chunkSize - 1)].pose.timestamp.convert(second));
+  }
+  bool written = std::fwrite(buffer.data(), 1, buffer.size(), file) ==
+                 buffer.size();
+
+  buffer.resize(chunkSize * fieldCount * 4);
+  for (std::size_t i = 0; i < chunks && written; i++) {
+    std::size_t first = i * (chunkSize - 1);
+    std::size_t count = std::min<std::size_t>(chunkSize, points - first);
+    std::fill(buffer.begin(), buffer.end(), 0);
+    for (std::size_t j = 0; j < count; j++) {
+      const TrajectoryPoint& point = trajectory[first + j];
+      float fields[fieldCount] = {
+          float(point.pose.timestamp.convert(second)),
+          float(point.pose.x.convert(meter)),
+          float(point.pose.y.convert(meter)),
+          float(point.pose.theta.convert(radian)),
+          float(point.distance.convert(meter)),
+          float(point.velocity.convert(mps)),
+          float(point.acceleration.convert(mps2)),
+          float(point.curvature)};
+      for (std::size_t field = 0; field < fieldCount; field++) {
+        putFloat(&buffer[4 * (field * chunkSize + j)], fields[field]);
+      }
+    }
+    written = std::fwrite(buffer.data(), 1, buffer.size(), file) ==
+              buffer.size();
+  }
+  return std::fclose(file) == 0 && written;
+}
+
+TrajectoryReader::~TrajectoryReader() { close(); }
+
+bool TrajectoryReader::open(const char* path, std::uint32_t prefetchPriority) {
+  close();
+  file = std::fopen(path, "rb");
+  if (!file) {
+    return false;
+  }
+  std::uint8_t header[headerSize];
+  if (std::fread(header, 1, headerSize, file) != headerSize ||
+      getU32(&header[0]) != magic || getU16(&header[4]) != version ||
+      getU16(&header[6]) != fieldCount || getU32(&header[12]) < 2 ||
+      getU32(&header[12]) > maxChunkSize) {
+    close();
+    return false;
+  }
+  // The point count and chunk size decide every allocation below, so they
+  // have to agree with what is actually on the card first.
+  pointCount = getU32(&header[8]);
+  chunkSize = getU32(&header[12]);
+  long size = -1;
+  if (std::fseek(file, 0, SEEK_END) == 0) {
+    size = std::ftell(file);
+  }
+  if (size < 0 || std::uint64_t(size) != fileSize(pointCount, chunkSize) ||
+      std::fseek(file, headerSize, SEEK_SET) != 0) {
+    close();
+    return false;
+  }
+  duration = getFloat(&header[16]);
+  length = getFloat(&header[20]);
+  halfTrack = getFloat(&header[24]) / 2;
+  std::vector<std::uint8_t> index(4 * chunkCount(pointCount, chunkSize));
+  if (std::fread(index.data(), 1, index.size(), file) != index.size()) {
+    close();
+    return false;
+  }
+  chunkStartTimes.resize(index.size() / 4);
+  for (std::size_t i = 0; i < chunkStartTimes.size(); i++) {
+    chunkStartTimes[i] = getFloat(&index[4 * i]);
+  }
+  for (ChunkBuffer& buffer : buffers) {
+    buffer.values.resize(chunkSize * fieldCount);
+    buffer.bytes.resize(buffer.values.size() * 4);
+  }
+  prefetchRunning = true;
+  prefetchExited = false;
+  prefetchTask = std::make_unique<pros::Task>(
+      [this] {
+        runPrefetch();
+        // Last access to the reader; close() may free it after this.
+        prefetchExited = true;
+      },
+      prefetchPriority, TASK_STACK_DEPTH_DEFAULT,
+      "Apollo Trajectory Prefetch");
+  // The first chunk is read here so the first tick doesn't wait for it.
+  if (!chunkStartTimes.empty()) {
+    useChunk(0);
+  }
+  return true;
+}
+
+void TrajectoryReader::close() {
+  stopPrefetch();
+  if (file) {
+    std::fclose(file);
+    file = nullptr;
+  }
+  pointCount = 0;
+  chunkStartTimes.clear();
+  for (ChunkBuffer& buffer : buffers) {
+    buffer = ChunkBuffer();
+  }
+  front = &buffers[0];
+  back = &buffers[1];
+  backState = buffer_idle;
+  blockingReads = 0;
+}
+
+void TrajectoryReader::stopPrefetch() {
+  if (!prefetchTask) {
+    return;
+  }
+  prefetchRunning = false;
+  prefetchTask->notify();
+  while (!prefetchExited) {
+    pros::delay(1);
+  }
+  prefetchTask.reset();
+}
+
+bool TrajectoryReader::isOpen() const { return file != nullptr; }
+
+void TrajectoryReader::runPrefetch() {
+  while (prefetchRunning) {
+    pros::Task::notify_take(true, TIMEOUT_MAX);
+    if (backState.load(std::memory_order_acquire) != buffer_loading) {
+      continue;
+    }
+    if (!loadChunk(back->index, *back)) {
+      back->index = SIZE_MAX;
+    }
+    backState.store(buffer_ready, std::memory_order_release);
+  }
+}
+
+bool TrajectoryReader::loadChunk(std::size_t index,
+                                 ChunkBuffer& buffer) const {
+  fileMutex.take(TIMEOUT_MAX);
+  bool read =
+      std::fseek(file, chunkOffset(index, chunkStartTimes.size(), chunkSize),
+                 SEEK_SET) == 0 &&
+      std::fread(buffer.bytes.data(), 1, buffer.bytes.size(), file) ==
+          buffer.bytes.size();
+  fileMutex.give();
+  if (!read) {
+    return false;
+  }
+  for (std::size_t i = 0; i < buffer.values.size(); i++) {
+    buffer.values[i] = getFloat(&buffer.bytes[4 * i]);
+  }
+  buffer.index = index;
+  buffer.points =
+      std::min<std::size_t>(chunkSize, pointCount - index * (chunkSize - 1));
+  return true;
+}
+
+// Makes the chunk the front buffer and asks for the one after it.
+bool TrajectoryReader::useChunk(std::size_t index) const {
+  if (front->index != index) {
+    if (backState.load(std::memory_order_acquire) == buffer_ready &&
+        back->index == index) {
+      std::swap(front, back);
+      backState.store(buffer_idle, std::memory_order_relaxed);
+    } else {
+      blockingReads++;
+      if (!loadChunk(index, *front)) {
+        front->index = SIZE_MAX;
+        return false;
+      }
+    }
+  }
+  if (index + 1 < chunkStartTimes.size()) {
+    prefetch(index + 1);
+  }
+  return true;
+}
+
+void TrajectoryReader::prefetch(std::size_t index) const {
+  int state = backState.load(std::memory_order_acquire);
+  if (state == buffer_loading ||
+      (state == buffer_ready && back->index == index)) {
+    return;
+  }
+  back->index = index;
+  backState.store(buffer_loading, std::memory_order_release);
+  prefetchTask->notify();
+}
+
+TrajectoryPoint TrajectoryReader::point(std::size_t index) const {
+  auto field = [this, index](std::size_t field) {
+    return double(front->values[field * chunkSize + index]);
+  };
+  double velocity = field(5);
+  double curvature = field(7);
+  TrajectoryPoint point;
+  point.pose = {field(1) * meter, field(2) * meter, field(3) * radian,
+                field(0) * second};
+  point.distance = field(4) * meter;
+  point.velocity = velocity * mps;
+  point.acceleration = field(6) * mps2;
+  point.angularVelocity = velocity * curvature * radps;
+  point.curvature = curvature;
+  point.leftVelocity = velocity * (1 - curvature * halfTrack) * mps;
+  point.rightVelocity = velocity * (1 + curvature * halfTrack) * mps;
+  return point;
+}
+
+TrajectoryPoint TrajectoryReader::sample(QTime time) const {
+  if (!file || chunkStartTimes.empty()) {
+    return TrajectoryPoint();
+  }
+  float t = time.convert(second);
+  std::size_t index =
+      std::upper_bound(chunkStartTimes.begin(), chunkStartTimes.end(), t) -
+      chunkStartTimes.begin();
+  if (!useChunk(index == 0 ? 0 : index - 1)) {
+    return TrajectoryPoint();
+  }
+  std::size_t points = front->points;
+  const float* times = front->values.data();
+  std::size_t after = std::upper_bound(times, times + points, t) - times;
+  if (after == 0) {
+    return point(0);
+  }
+  if (after == points) {
+    return point(points - 1);
+  }
+  return interpolate(point(after - 1), point(after), time);
+}
+
+QTime TrajectoryReader::getDuration() const { return duration * second; }
+QLength TrajectoryReader::getLength() const { return length * meter; }
+std::size_t TrajectoryReader::size() const { return pointCount; }
+std::uint32_t TrajectoryReader::getBlockingReads() const {
+  return blockingReads;
+}
+}  // namespace apollo
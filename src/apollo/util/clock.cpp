@@ -0,0 +1,11 @@
+#include "apollo/util/clock.hpp"
+
+#include "pros/rtos.hpp"
+
+namespace apollo::util {
+std::uint32_t ProsClock::millis() const { return pros::millis(); }
+std::uint64_t ProsClock::micros() const { return pros::micros(); }
+void ProsClock::delayUntil(std::uint32_t* previousTime, std::uint32_t delta) {
+  pros::Task::delay_until(previousTime, delta);
+}
+}  // namespace apollo::util
@@ -78,6 +78,7 @@ void opcontrol() {
 	pros::Motor left_mtr(1);
 	pros::Motor right_mtr(2);
 
+	std::uint32_t now = pros::millis();
 	while (true) {
 		pros::lcd::print(0, "%d %d %d", (pros::lcd::read_buttons() & LCD_BTN_LEFT) >> 2,
 		                 (pros::lcd::read_buttons() & LCD_BTN_CENTER) >> 1,
@@ -88,6 +89,6 @@ void opcontrol() {
 		left_mtr = left;
 		right_mtr = right;
 
-		pros::delay(20);
+		pros::Task::delay_until(&now, 20);
 	}
 }
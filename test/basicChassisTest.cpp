@@ -0,0 +1,201 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+
+#include "apollo/chassis/basicChassis.hpp"
+#include "apollo/chassis/tankDrive.hpp"
+#include "apollo/chassis/xDrive.hpp"
+#include "harness.hpp"
+#include "simDevices.hpp"
+
+using namespace apollo;
+
+namespace {
+// 200 rpm on 4 inch wheels tops out at 1.06 m/s.
+XDrive makeXDrive() {
+  return XDrive({1}, {2}, {3}, {4}, 10, 200, 1.0, 4.0, 20 * centimeter);
+}
+constexpr DriveCurve deadbandCurve = DriveCurve::linear(20);
+
+// Shows the kinematics the control task is running with.
+class InspectedXDrive : public XDrive {
+ public:
+  using XDrive::XDrive;
+  QLength tickSideRadius() const { return kinematics.getSideRadius(); }
+};
+
+// The baseline the policy template is measured against: X-drive
+// kinematics behind an interface, so every kinematics call in a tick is an
+// indirect call the compiler can't inline, as in a chassis built on
+// virtual kinematics.
+class KinematicsInterface {
+ public:
+  virtual ~KinematicsInterface() = default;
+  virtual FourWheelVelocities inverse(const HolonomicSpeeds& speeds) const = 0;
+  virtual HolonomicSpeeds forward(const FourWheelVelocities& wheels) const = 0;
+  virtual QLength getSideRadius() const = 0;
+  virtual double getSideScale() const = 0;
+  virtual double getStrafeScale() const = 0;
+};
+class XDriveKinematicsInterface : public KinematicsInterface {
+ public:
+  explicit XDriveKinematicsInterface(QLength trackRadius)
+      : kinematics(M_SQRT1_2, trackRadius) {}
+  FourWheelVelocities inverse(const HolonomicSpeeds& speeds) const override {
+    return kinematics.inverse(speeds);
+  }
+  HolonomicSpeeds forward(const FourWheelVelocities& wheels) const override {
+    return kinematics.forward(wheels);
+  }
+  QLength getSideRadius() const override {
+    return kinematics.getSideRadius();
+  }
+  double getSideScale() const override { return kinematics.getSideScale(); }
+  double getStrafeScale() const override {
+    return kinematics.getStrafeScale();
+  }
+
+ private:
+  FourWheelKinematics kinematics;
+};
+struct VirtualKinematics {
+  using Wheels = FourWheelVelocities;
+  static constexpr std::size_t wheelCount = FourWheelKinematics::wheelCount;
+  static constexpr std::array<bool, wheelCount> leftWheels =
+      FourWheelKinematics::leftWheels;
+  static std::array<QSpeed, wheelCount> toArray(const Wheels& wheels) {
+    return FourWheelKinematics::toArray(wheels);
+  }
+  static Wheels fromArray(const std::array<QSpeed, wheelCount>& wheels) {
+    return FourWheelKinematics::fromArray(wheels);
+  }
+  Wheels inverse(const HolonomicSpeeds& speeds) const {
+    return kinematics->inverse(speeds);
+  }
+  HolonomicSpeeds forward(const Wheels& wheels) const {
+    return kinematics->forward(wheels);
+  }
+  QLength getSideRadius() const { return kinematics->getSideRadius(); }
+  double getSideScale() const { return kinematics->getSideScale(); }
+  double getStrafeScale() const { return kinematics->getStrafeScale(); }
+  const KinematicsInterface* kinematics;
+};
+
+// Mean cost of one control tick with a drive motion running, the clock
+// moving 10 ms per tick as it would under ControlLoop.
+template <typename Update>
+double tickNanoseconds(Update&& update) {
+  return test::nanosecondsPerCall(
+      [&] {
+        sim::advanceTime(10000);
+        update();
+      },
+      10000);
+}
+}  // namespace
+
+APOLLO_TEST(moveVelocityKeepsTheDirectionUnderTheCap) {
+  sim::reset();
+  XDrive drive = makeXDrive();
+  // Asks the front left and back right wheels for three times what the
+  // other two get, and all of them for more than the top speed.
+  drive.moveVelocity({2 * mps, 1 * mps, 0 * radps});
+  CHECK(sim::motor(1).voltage == 12000);
+  CHECK(sim::motor(4).voltage == 12000);
+  CHECK(std::abs(sim::motor(2).voltage - 4000) <= 1);
+  CHECK(std::abs(sim::motor(3).voltage - 4000) <= 1);
+}
+
+APOLLO_TEST(driverAxesGoThroughTheDriveCurve) {
+  sim::reset();
+  XDrive drive = makeXDrive();
+  drive.setDriveCurve(deadbandCurve);
+  sim::controllerAxis(E_CONTROLLER_ANALOG_LEFT_Y) = 15;
+  drive.setArcade(E_CONTROLLER_ANALOG_LEFT_Y, E_CONTROLLER_ANALOG_RIGHT_X,
+                  nullptr);
+  for (int port : {1, 2, 3, 4}) {
+    CHECK(sim::motor(port).voltage == 0);
+  }
+  // Full stick forward is the top side speed, which is every wheel at its
+  // top speed on an X-drive.
+  sim::controllerAxis(E_CONTROLLER_ANALOG_LEFT_Y) = 127;
+  drive.setArcade(E_CONTROLLER_ANALOG_LEFT_Y, E_CONTROLLER_ANALOG_RIGHT_X,
+                  nullptr);
+  for (int port : {1, 2, 3, 4}) {
+    CHECK(std::abs(sim::motor(port).voltage - 12000) <= 1);
+  }
+}
+
+APOLLO_TEST(feedforwardGainsReachTheMotions) {
+  sim::reset();
+  XDrive drive = makeXDrive();
+  CHECK(drive.getFeedforward().getGains().kV > 0);
+  drive.setFeedforward({500, 9000, 300});
+  CHECK_NEAR(drive.getFeedforward().getGains().kS, 500, 1e-9);
+  TrajectoryConstraints constraints =
+      drive.getTrajectoryConstraints(1 * mps2);
+  // The virtual tank sides sit at the X-drive's side radius.
+  CHECK_NEAR(constraints.trackWidth.convert(centimeter),
+             2 * 20 / M_SQRT1_2, 1e-9);
+}
+
+// Compares one tick of the same X-drive called straight on its
+// BasicChassis, as a user holding the concrete type would, and through
+// Chassis& as ControlLoop does, with Tank's tick for reference.
+APOLLO_TEST(trackRadiusChangesApplyOnTheNextTick) {
+  sim::reset();
+  InspectedXDrive drive({1}, {2}, {3}, {4}, 10, 200, 1.0, 4.0,
+                        20 * centimeter);
+  QLength before = drive.getKinematics().getSideRadius();
+  drive.setTrackRadius(30 * centimeter);
+  QLength after = drive.getKinematics().getSideRadius();
+  CHECK(after > before);
+  CHECK(drive.tickSideRadius() == before);
+  drive.update();
+  CHECK(drive.tickSideRadius() == after);
+}
+
+// Ticks are measured in alternating rounds and each keeps its fastest, so
+// a slow stretch on the machine hits all of them alike.
+APOLLO_TEST(tickCost) {
+  sim::reset();
+  XDrive drive = makeXDrive();
+  XDriveKinematicsInterface interface(20 * centimeter);
+  const KinematicsInterface* virtualKinematics = &interface;
+  test::doNotOptimize(virtualKinematics);
+  BasicChassis<VirtualKinematics> baseline({{{5}, {6}, {7}, {8}}}, 9, 200,
+                                           1.0, 4.0, {virtualKinematics});
+  Tank tank({11, 12}, {13, 14}, 20, 200, 1.0, 4.0);
+  tank.setTrackingOffsets(15 * centimeter, 15 * centimeter);
+  drive.setDrivePID(1000 * meter, QSpeed());
+  baseline.setDrivePID(1000 * meter, QSpeed());
+  tank.setDrivePID(1000 * meter, QSpeed());
+  BasicChassis<FourWheelKinematics>& basic = drive;
+  Chassis* chassis = &drive;
+  Chassis* tankChassis = &tank;
+  test::doNotOptimize(chassis);
+  test::doNotOptimize(tankChassis);
+  double direct = INFINITY;
+  double adapted = INFINITY;
+  double virtualTick = INFINITY;
+  double tankTick = INFINITY;
+  for (int round = 0; round < 5; round++) {
+    direct = std::fmin(direct, tickNanoseconds([&] { basic.update(); }));
+    adapted = std::fmin(adapted, tickNanoseconds([&] { chassis->update(); }));
+    virtualTick =
+        std::fmin(virtualTick, tickNanoseconds([&] { baseline.update(); }));
+    tankTick =
+        std::fmin(tankTick, tickNanoseconds([&] { tankChassis->update(); }));
+  }
+  std::printf("  BasicChassis direct: %.1f ns\n", direct);
+  std::printf("  BasicChassis through Chassis&: %.1f ns\n", adapted);
+  std::printf("  virtual kinematics baseline: %.1f ns\n", virtualTick);
+  std::printf("  Tank through Chassis&: %.1f ns\n", tankTick);
+  CHECK(drive.getSensorFrame().leftMotorCount == 2);
+  CHECK(baseline.getSensorFrame().leftMotorCount == 2);
+  // Device reads dominate a tick, so a few indirect calls are close to
+  // noise. The policy template has to keep up with the virtual baseline,
+  // and the Chassis adapter's one extra call must not show.
+  CHECK(direct <= virtualTick * 1.15);
+  CHECK(adapted <= direct * 1.15);
+}
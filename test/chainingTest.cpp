@@ -0,0 +1,149 @@
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "apollo/chassis/motionRunner.hpp"
+#include "apollo/chassis/motions.hpp"
+#include "harness.hpp"
+#include "tankSim.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr ProfileConstraints constraints{1 * mps, 2 * mps2, QJerk()};
+constexpr PIDGains driveGains{20000, 0, 2000};
+constexpr PIDGains headingGains{20000, 0, 0};
+constexpr PIDGains turnGains{12000, 0, 600};
+constexpr QSpeed handoffVelocity = 0.6 * mps;
+
+// Solves both profiles from the runner's chain speeds when the drive is
+// queued, the way Tank::setDrivePID does.
+std::shared_ptr<Motion> drive(MotionRunner& runner, QLength distance) {
+  QSpeed entryVelocity, endVelocity;
+  runner.getChainSpeeds(distance, entryVelocity, endVelocity);
+  auto motion = std::make_shared<DriveMotion>(
+      MotionProfile(distance, constraints, entryVelocity),
+      MotionProfile(distance, constraints, entryVelocity, endVelocity), 12000,
+      driveGains, headingGains, Feedforward(FeedforwardGains{0, 8000, 400}));
+  motion->setExitConditions(defaultDriveExit);
+  return motion;
+}
+std::shared_ptr<Motion> turn(QAngle angle) {
+  auto motion = std::make_shared<TurnMotion>(angle, 12000, turnGains);
+  motion->setExitConditions(defaultTurnExit);
+  return motion;
+}
+// Forward, on along the same line, a right angle turn and out again.
+constexpr std::size_t routineLength = 4;
+std::shared_ptr<Motion> routineStep(MotionRunner& runner, std::size_t step) {
+  switch (step) {
+    case 0:
+      return drive(runner, 1 * meter);
+    case 1:
+      return drive(runner, 0.6 * meter);
+    case 2:
+      return turn(90 * degree);
+    default:
+      return drive(runner, 0.8 * meter);
+  }
+}
+
+struct RoutineResult {
+  double time;
+  double slowestHandoff;  // m/s, over the drive to drive handoff
+  bool completed;
+};
+
+// Chained, the whole routine is queued up front like an autonomous would;
+// otherwise each motion starts once the previous one has settled.
+RoutineResult runRoutine(test::TankSim& sim, bool chained) {
+  MotionRunner runner;
+  std::vector<MotionHandle> handles;
+  std::size_t next = 0;
+  if (chained) {
+    runner.beginChain(handoffVelocity);
+    for (; next < routineLength; next++) {
+      handles.push_back(runner.start(routineStep(runner, next)));
+    }
+    runner.endChain();
+  }
+  RoutineResult result{0, INFINITY, true};
+  while (sim.time < 20) {
+    if (next < routineLength &&
+        (handles.empty() || handles.back().isSettled())) {
+      handles.push_back(runner.start(routineStep(runner, next++)));
+    }
+    DriveOutput output;
+    runner.run(sim.context(), output);
+    if (next == routineLength && handles.back().isSettled()) {
+      break;
+    }
+    sim.step(output);
+    if (handles.size() > 1 && handles[0].isSettled() &&
+        !handles[1].isSettled()) {
+      double speed = (sim.leftSpeed + sim.rightSpeed) / 2;
+      result.slowestHandoff = std::fmin(result.slowestHandoff, speed);
+    }
+  }
+  result.time = sim.time;
+  for (const MotionHandle& handle : handles) {
+    result.completed = result.completed &&
+                       handle.getExitReason() != exit_timeout &&
+                       handle.getExitReason() != exit_cancelled;
+  }
+  return result;
+}
+}  // namespace
+
+APOLLO_TEST(chainingSavesRoutineTime) {
+  test::TankSim stopping;
+  test::TankSim chaining;
+  RoutineResult stopped = runRoutine(stopping, false);
+  RoutineResult chained = runRoutine(chaining, true);
+  std::printf("  routine: %.2f s stopping, %.2f s chained, %.2f s saved\n",
+              stopped.time, chained.time, stopped.time - chained.time);
+  CHECK(stopped.completed);
+  CHECK(chained.completed);
+  CHECK(stopped.time - chained.time > 0.5);
+  // Both end up 1.6 m out and 0.8 m to the left. The chained turn starts
+  // at the handoff speed, so it rolls on a little further first.
+  CHECK_NEAR(stopping.x, 1.6, 0.02);
+  CHECK_NEAR(stopping.y, 0.8, 0.02);
+  CHECK_NEAR(chaining.x, 1.6, 0.1);
+  CHECK_NEAR(chaining.y, 0.8, 0.05);
+  CHECK_NEAR(chaining.theta, M_PI / 2, 0.05);
+}
+
+APOLLO_TEST(chainedDrivesKeepMoving) {
+  test::TankSim sim;
+  RoutineResult chained = runRoutine(sim, true);
+  std::printf("  slowest drive to drive handoff: %.2f m/s\n",
+              chained.slowestHandoff);
+  CHECK(chained.slowestHandoff > 0.4);
+}
+
+APOLLO_TEST(chainSpeedsFollowTheQueue) {
+  MotionRunner runner;
+  QSpeed entryVelocity, endVelocity;
+  runner.getChainSpeeds(1 * meter, entryVelocity, endVelocity);
+  CHECK(entryVelocity == QSpeed());
+  CHECK(endVelocity == QSpeed());
+  runner.beginChain(handoffVelocity);
+  // The first drive is handed over at rest and hands off backwards.
+  runner.getChainSpeeds(-1 * meter, entryVelocity, endVelocity);
+  CHECK(entryVelocity == QSpeed());
+  CHECK_NEAR(endVelocity.convert(mps), -0.6, 1e-12);
+  runner.start(drive(runner, 1 * meter));
+  runner.getChainSpeeds(0.5 * meter, entryVelocity, endVelocity);
+  CHECK_NEAR(entryVelocity.convert(mps), 0.6, 1e-12);
+  CHECK_NEAR(endVelocity.convert(mps), 0.6, 1e-12);
+  // A turn hands off without driving forward.
+  runner.start(turn(90 * degree));
+  runner.getChainSpeeds(0.5 * meter, entryVelocity, endVelocity);
+  CHECK(entryVelocity == QSpeed());
+  runner.endChain();
+  runner.getChainSpeeds(0.5 * meter, entryVelocity, endVelocity);
+  CHECK(entryVelocity == QSpeed());
+  CHECK(endVelocity == QSpeed());
+}
@@ -0,0 +1,79 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "apollo/chassis/characterization.hpp"
+#include "harness.hpp"
+#include "tankSim.hpp"
+
+using namespace apollo;
+
+namespace {
+// The sim is exactly kS + kV v + kA a with these gains.
+constexpr FeedforwardGains simGains{600, 8000, 400};
+
+void runSequence(test::TankSim& sim, CharacterizationSequence& sequence) {
+  sim.frictionVoltage = simGains.kS;
+  sim.run(sequence, 120);
+}
+}  // namespace
+
+APOLLO_TEST(sequenceRunsEveryTestBothWays) {
+  test::TankSim sim;
+  CharacterizationSequence sequence;
+  runSequence(sim, sequence);
+  CHECK(sequence.getState()->settled);
+  CHECK(sequence.getState()->reason == exit_completed);
+  using sequenceRun = CharacterizationSequence::runType;
+  for (std::size_t i = 0; i < CharacterizationSequence::runCount; i++) {
+    const std::vector<CharacterizationSample>& samples =
+        sequence.getSamples(static_cast<sequenceRun>(i));
+    CHECK(samples.size() > 100);
+    // Forward runs drive forwards, backward runs backwards.
+    double travelled = samples.back().position.convert(meter);
+    CHECK(i % 2 == 0 ? travelled > 0.1 : travelled < -0.1);
+    // Every run starts from rest, so the first tick covers at most the
+    // 1.1 mm a full step accelerates the sim from standstill.
+    CHECK(std::fabs(samples[1].position.convert(meter)) < 1.5e-3);
+  }
+  // Each backward run undoes the forward one.
+  CHECK(std::fabs(sim.x) < 0.2);
+}
+
+APOLLO_TEST(fitRecoversSimGains) {
+  test::TankSim sim;
+  CharacterizationSequence sequence;
+  runSequence(sim, sequence);
+  FeedforwardGains gains;
+  CHECK(sequence.fit(gains));
+  std::printf("  fit kS %.0f kV %.0f kA %.0f\n", gains.kS, gains.kV,
+              gains.kA);
+  CHECK_NEAR(gains.kS, simGains.kS, 30);
+  CHECK_NEAR(gains.kV, simGains.kV, 160);
+  CHECK_NEAR(gains.kA, simGains.kA, 40);
+}
+
+APOLLO_TEST(logsRoundTripToTheSameFit) {
+  test::TankSim sim;
+  CharacterizationSequence sequence;
+  runSequence(sim, sequence);
+  const char* prefix = "characterizationTest";
+  CHECK(sequence.writeLogs(prefix));
+  std::vector<std::vector<CharacterizationSample>> runs;
+  for (const char* name : {"quasistatic_forward", "quasistatic_backward",
+                           "step_forward", "step_backward"}) {
+    std::vector<CharacterizationSample> samples;
+    std::string path = std::string(prefix) + "_" + name + ".csv";
+    CHECK(readCharacterizationLog(path.c_str(), samples));
+    runs.push_back(samples);
+    std::remove(path.c_str());
+  }
+  FeedforwardGains logged;
+  FeedforwardGains direct;
+  CHECK(fitFeedforward(runs, logged));
+  CHECK(sequence.fit(direct));
+  CHECK_NEAR(logged.kS, direct.kS, 1);
+  CHECK_NEAR(logged.kV, direct.kV, 5);
+  CHECK_NEAR(logged.kA, direct.kA, 5);
+}
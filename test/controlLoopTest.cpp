@@ -0,0 +1,108 @@
+#include <chrono>
+#include <thread>
+
+#include "apollo/chassis/controlLoop.hpp"
+#include "fakeChassis.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+APOLLO_TEST(ticksOnThePeriod) {
+  util::ManualClock clock;
+  test::FakeChassis chassis(&clock);
+  chassis.updateTime = 2000;
+  ControlLoop loop(chassis, ControlLoop::period_10ms, clock);
+  for (int i = 0; i < 100; i++) {
+    loop.step();
+  }
+  ControlLoop::Statistics statistics = loop.getStatistics();
+  CHECK(chassis.updates == 100);
+  CHECK(statistics.ticks == 100);
+  CHECK(statistics.overruns == 0);
+  CHECK(statistics.lastPeriod == 10000);
+  CHECK(statistics.lastExecutionTime == 2000);
+  CHECK(statistics.maxJitter == 0);
+  CHECK(clock.millis() == 1000);
+}
+
+APOLLO_TEST(measuresJitter) {
+  util::ManualClock clock;
+  test::FakeChassis chassis(&clock);
+  ControlLoop loop(chassis, ControlLoop::period_10ms, clock);
+  loop.step();
+  // Wake up 300 us late once: that period is long and the next one short.
+  clock.advance(300);
+  loop.step();
+  loop.step();
+  loop.step();
+  ControlLoop::Statistics statistics = loop.getStatistics();
+  CHECK(statistics.maxJitter == 300);
+  CHECK_NEAR(statistics.meanJitter, 200, 1e-9);
+}
+
+APOLLO_TEST(resynchronisesAfterOverrun) {
+  util::ManualClock clock;
+  test::FakeChassis chassis(&clock);
+  ControlLoop loop(chassis, ControlLoop::period_10ms, clock);
+  loop.step();
+  chassis.updateTime = 25000;
+  loop.step();
+  chassis.updateTime = 0;
+  std::uint32_t afterOverrun = clock.millis();
+  loop.step();
+  ControlLoop::Statistics statistics = loop.getStatistics();
+  CHECK(statistics.overruns == 1);
+  CHECK(statistics.maxExecutionTime == 25000);
+  // One full period after the late tick, not a burst of catch up ticks.
+  CHECK(clock.millis() - afterOverrun == 10);
+}
+
+APOLLO_TEST(resetAppliesOnTheNextTick) {
+  util::ManualClock clock;
+  test::FakeChassis chassis(&clock);
+  ControlLoop loop(chassis, ControlLoop::period_10ms, clock);
+  for (int i = 0; i < 5; i++) {
+    loop.step();
+  }
+  loop.resetStatistics();
+  CHECK(loop.getStatistics().ticks == 5);
+  loop.step();
+  ControlLoop::Statistics statistics = loop.getStatistics();
+  CHECK(statistics.ticks == 1);
+  CHECK(statistics.lastPeriod == 0);
+}
+
+APOLLO_TEST(statisticsReadWhileRunningAreWhole) {
+  util::ManualClock clock;
+  test::FakeChassis chassis(&clock);
+  // Every tick overruns, so a snapshot taken between the tick count and
+  // the overrun count being bumped would show them apart.
+  chassis.updateTime = 25000;
+  ControlLoop loop(chassis, ControlLoop::period_10ms, clock);
+  loop.start();
+  while (chassis.updates < 20000) {
+    ControlLoop::Statistics statistics = loop.getStatistics();
+    CHECK(statistics.overruns == statistics.ticks);
+  }
+  loop.stop();
+}
+
+APOLLO_TEST(stopJoinsTheTask) {
+  test::FakeChassis chassis;
+  for (int i = 0; i < 20; i++) {
+    auto loop = std::make_unique<ControlLoop>(chassis,
+                                              ControlLoop::period_5ms);
+    loop->start();
+    CHECK(loop->isRunning());
+    std::this_thread::sleep_for(std::chrono::milliseconds(12));
+    loop->stop();
+    CHECK(!loop->isRunning());
+    std::uint32_t updates = chassis.updates;
+    // Destroying the loop straight after stop() must be safe, and the task
+    // must not touch the chassis again.
+    loop.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(chassis.updates == updates);
+  }
+  CHECK(chassis.updates > 0);
+}
@@ -0,0 +1,248 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "apollo/chassis/currentBudget.hpp"
+#include "apollo/chassis/slipDetector.hpp"
+#include "apollo/chassis/tankDrive.hpp"
+#include "harness.hpp"
+#include "simDevices.hpp"
+
+using namespace apollo;
+
+namespace {
+std::atomic<long> allocations{0};
+
+constexpr CurrentBudget::GroupLimits driveLimits{0, 500, 2500, 1500};
+
+int driveReads() {
+  int reads = 0;
+  for (int port : {1, 2, 3, 4}) {
+    reads += sim::motor(port).currentDrawReads;
+  }
+  return reads;
+}
+int limitWrites(std::initializer_list<int> ports) {
+  int writes = 0;
+  for (int port : ports) {
+    writes += sim::motor(port).currentLimitWrites;
+  }
+  return writes;
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+  allocations++;
+  if (void* memory = std::malloc(size ? size : 1)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept {
+  std::free(memory);
+}
+
+APOLLO_TEST(driveGroupsUseTheFrameCurrents) {
+  sim::reset();
+  Tank chassis({1, 2}, {3, 4}, 10, 200, 1.0, 4.0);
+  chassis.enableCurrentBudget(driveLimits, {8000, 500, 100});
+  chassis.update();
+  for (int port : {1, 2}) {
+    sim::motor(port).currentDraw = 2000;
+  }
+  for (int port : {3, 4}) {
+    sim::motor(port).currentDraw = 200;
+  }
+  int reads = driveReads();
+  for (int tick = 0; tick < 10; tick++) {
+    chassis.update();
+  }
+  // One read per motor per tick, all of them from sampling the frame.
+  CHECK(driveReads() - reads == 40);
+  const CurrentBudget& budget = chassis.getCurrentBudget();
+  CHECK(budget.getLimit(0) == 2500);
+  CHECK(budget.getLimit(1) < budget.getLimit(0));
+  CHECK(budget.getLimit(0) * 2 + budget.getLimit(1) * 2 <= 8000);
+}
+
+APOLLO_TEST(stepRoundingKeepsTheMinimum) {
+  sim::reset();
+  apollo::MotorGroup motors({5, 6});
+  CurrentBudget budget({1000, 500, 300});
+  budget.addGroup(motors, driveLimits);
+  budget.update();
+  // 500 rounds down to 300 on a 300 mA step, under the minimum.
+  CHECK(budget.getLimit(0) == 500);
+  CHECK(sim::motor(5).currentLimit == 500);
+}
+
+APOLLO_TEST(higherPriorityGroupsAreServedFirst) {
+  sim::reset();
+  apollo::MotorGroup drive({5, 6});
+  apollo::MotorGroup intake({7});
+  CurrentBudget budget({4000, 500, 100});
+  std::size_t driveGroup = budget.addGroup(drive, driveLimits);
+  std::size_t intakeGroup = budget.addGroup(intake, {1, 500, 2500, 1500});
+  for (int port : {5, 6, 7}) {
+    sim::motor(port).currentDraw = 2000;
+  }
+  budget.update();
+  // The intake gets its draw plus headroom, the drive what is left.
+  CHECK(budget.getLimit(intakeGroup) == 2500);
+  CHECK(budget.getLimit(driveGroup) == 700);
+  // Slipping caps a group at its slip limit even with current to spare.
+  budget.setParameters({20000, 500, 100});
+  budget.setSlipping(driveGroup, true);
+  budget.update();
+  CHECK(budget.getLimit(driveGroup) == 1500);
+}
+
+// Ticks of 1/64 s keep the hold time comparisons exact.
+constexpr double slipTick = 1.0 / 64;
+
+APOLLO_TEST(slipNeedsTheMismatchToLastHoldTime) {
+  SlipDetector detector({3 * mps2, 3 * slipTick * second, 1});
+  double speed = 0;
+  int tick = 0;
+  auto step = [&](double acceleration) {
+    speed += acceleration * slipTick;
+    tick++;
+    return detector.update(speed * mps, 0 * mps2, tick * slipTick * second);
+  };
+  detector.update(0 * mps, 0 * mps2, 0 * second);
+  // Wheels spinning up at 10 m/s^2 for one tick short of the hold time,
+  // then rolling on.
+  for (int i = 0; i < 3; i++) {
+    CHECK(!step(10));
+  }
+  CHECK(!step(0));
+  // A fresh mismatch starts the hold over and slips once it has lasted
+  // the whole hold time.
+  CHECK(!step(10));
+  CHECK(!step(10));
+  CHECK(!step(10));
+  CHECK(step(10));
+  CHECK(detector.isSlipping());
+}
+
+APOLLO_TEST(slipClearsUnderHalfTheThreshold) {
+  SlipDetector detector({3 * mps2, 2 * slipTick * second, 1});
+  double speed = 0;
+  int tick = 0;
+  auto step = [&](double acceleration) {
+    speed += acceleration * slipTick;
+    tick++;
+    return detector.update(speed * mps, 0 * mps2, tick * slipTick * second);
+  };
+  detector.update(0 * mps, 0 * mps2, 0 * second);
+  for (int i = 0; i < 3; i++) {
+    step(10);
+  }
+  CHECK(detector.isSlipping());
+  // Under the threshold but over half of it holds the slip.
+  for (int i = 0; i < 5; i++) {
+    CHECK(step(2));
+  }
+  CHECK(!step(1));
+  // And once clear, staying between the two doesn't set it again.
+  for (int i = 0; i < 5; i++) {
+    CHECK(!step(2));
+  }
+}
+
+APOLLO_TEST(tractionControlAddsTheDriveGroups) {
+  sim::reset();
+  Tank chassis({1, 2}, {3, 4}, 10, 200, 1.0, 4.0);
+  chassis.enableTractionControl(Tank::imu_x);
+  CHECK(chassis.getCurrentBudget().size() == 2);
+  // The wheels spin up by 20 rpm a tick, about 10 m/s^2, while the IMU
+  // feels nothing and the motors pull near their maximum.
+  for (int tick = 0; tick < 30; tick++) {
+    sim::advanceTime(10000);
+    for (int port : {1, 2, 3, 4}) {
+      sim::motor(port).velocity = 20.0 * tick;
+      sim::motor(port).currentDraw = 2400;
+    }
+    chassis.update();
+  }
+  CHECK(chassis.isSlipping());
+  CHECK(chassis.getCurrentBudget().getLimit(0) == 1500);
+  CHECK(chassis.getCurrentBudget().getLimit(1) == 1500);
+  CHECK(sim::motor(1).currentLimit == 1500);
+  // Enabling the budget afterwards only sets the drive limits again.
+  chassis.enableCurrentBudget(driveLimits);
+  CHECK(chassis.getCurrentBudget().size() == 2);
+}
+
+APOLLO_TEST(ticksDontAllocate) {
+  sim::reset();
+  Tank chassis({1, 2}, {3, 4}, 10, 200, 1.0, 4.0);
+  chassis.enableCurrentBudget(driveLimits);
+  chassis.enableTractionControl(Tank::imu_x);
+  chassis.update();
+  long before = allocations;
+  for (int tick = 0; tick < 1000; tick++) {
+    sim::advanceTime(10000);
+    sim::motor(1).currentDraw = tick % 3000;
+    chassis.update();
+  }
+  CHECK(allocations - before == 0);
+}
+
+// Per tick cost of the budget and slip detection, on top of a Tank tick
+// and on their own.
+APOLLO_TEST(tickCost) {
+  sim::reset();
+  Tank plain({1, 2}, {3, 4}, 10, 200, 1.0, 4.0);
+  Tank budgeted({11, 12}, {13, 14}, 20, 200, 1.0, 4.0);
+  budgeted.enableCurrentBudget(driveLimits, {9000, 500, 100});
+  budgeted.enableTractionControl(Tank::imu_x);
+  apollo::MotorGroup arm({21, 22});
+  budgeted.getCurrentBudget().addGroup(arm, {1, 500, 2500, 1500});
+  int tick = 0;
+  auto load = [&tick](std::initializer_list<int> ports) {
+    for (int port : ports) {
+      sim::motor(port).currentDraw = 1000 + (tick * 37 + port * 101) % 1500;
+    }
+  };
+  double plainTick = test::nanosecondsPerCall(
+      [&] {
+        sim::advanceTime(10000);
+        load({1, 2, 3, 4});
+        tick++;
+        plain.update();
+      },
+      100000);
+  int writes = limitWrites({11, 12, 13, 14, 21, 22});
+  int ticks = tick;
+  double budgetedTick = test::nanosecondsPerCall(
+      [&] {
+        sim::advanceTime(10000);
+        load({11, 12, 13, 14, 21, 22});
+        tick++;
+        budgeted.update();
+      },
+      100000);
+  double writesPerTick = static_cast<double>(
+                             limitWrites({11, 12, 13, 14, 21, 22}) - writes) /
+                         (tick - ticks);
+  SlipDetector detector;
+  double speed = 0;
+  double slipCost = test::nanosecondsPerCall(
+      [&] {
+        speed = speed < 1 ? speed + 0.01 : 0;
+        sim::advanceTime(10000);
+        test::doNotOptimize(detector.update(speed * mps, 0.5 * mps2,
+                                            sim::now() * microsecond));
+      },
+      1000000);
+  std::printf("  Tank tick: %.1f ns, with budget and traction control: "
+              "%.1f ns\n",
+              plainTick, budgetedTick);
+  std::printf("  limit writes per tick: %.2f, slip detector: %.1f ns\n",
+              writesPerTick, slipCost);
+  CHECK(budgetedTick - plainTick < 1000);
+  CHECK(slipCost < 200);
+}
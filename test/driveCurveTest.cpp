@@ -0,0 +1,127 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include "apollo/chassis/driveCurve.hpp"
+#include "apollo/chassis/tankDrive.hpp"
+#include "harness.hpp"
+#include "simDevices.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr DriveCurve exponentialCurve = DriveCurve::exponential(20, 10);
+constexpr DriveCurve cubicCurve = DriveCurve::cubic(0.5, 10);
+constexpr DriveCurve turnDeadband = DriveCurve::linear(40);
+
+// Reads the table directly, the way operator() indexes it.
+class CurveTable : public DriveCurve {
+ public:
+  explicit CurveTable(const DriveCurve& curve) : DriveCurve(curve) {}
+  double at(std::uint8_t index) const { return table[index]; }
+};
+
+// Travel past the deadband of 10 as a fraction of what is left of it.
+double stretched(int raw) { return (std::abs(raw) - 10) / 117.0; }
+
+Tank makeTank() { return Tank({1, 2}, {3, 4}, 10, 200, 1.0, 4.0); }
+
+void setStick(std::int32_t forward, std::int32_t turn) {
+  sim::controllerAxis(E_CONTROLLER_ANALOG_LEFT_Y) = forward;
+  sim::controllerAxis(E_CONTROLLER_ANALOG_RIGHT_X) = turn;
+}
+}  // namespace
+
+APOLLO_TEST(exponentialTableFollowsTheCurve) {
+  for (int raw = -10; raw <= 10; raw++) {
+    CHECK(exponentialCurve(raw) == 0);
+  }
+  double center = std::exp(-2.0);
+  double previous = 0;
+  for (int raw = 11; raw <= 127; raw++) {
+    double x = stretched(raw);
+    double expected = (center + std::exp((x - 1) * 12.7) * (1 - center)) * x;
+    CHECK_NEAR(exponentialCurve(raw), expected, 1e-9);
+    CHECK(exponentialCurve(-raw) == -exponentialCurve(raw));
+    CHECK(exponentialCurve(raw) > previous);
+    previous = exponentialCurve(raw);
+  }
+  // Flat near center: half stick gives well under half output.
+  CHECK(exponentialCurve(64) < 0.25);
+}
+
+APOLLO_TEST(cubicTableFollowsTheCurve) {
+  for (int raw = -10; raw <= 10; raw++) {
+    CHECK(cubicCurve(raw) == 0);
+  }
+  for (int raw = 11; raw <= 127; raw++) {
+    double x = stretched(raw);
+    CHECK_NEAR(cubicCurve(raw), 0.5 * x * x * x + 0.5 * x, 1e-12);
+    CHECK(cubicCurve(-raw) == -cubicCurve(raw));
+  }
+  CHECK(cubicCurve(127) == 1);
+  CHECK(cubicCurve(-128) == -1);
+}
+
+APOLLO_TEST(negativeInputsIndexByTheirLowByte) {
+  CurveTable table(linearDriveCurve);
+  // -127 is 0x81 as a byte, so it reads entry 129 of the table.
+  CHECK(static_cast<std::uint8_t>(-127) == 129);
+  CHECK(table.at(static_cast<std::uint8_t>(-127)) == -1);
+  CHECK(linearDriveCurve(-127) == table.at(129));
+  CHECK(table.at(127) == 1);
+  CHECK(table.at(static_cast<std::uint8_t>(-1)) == -1 / 127.0);
+  CHECK(linearDriveCurve(-64) == -linearDriveCurve(64));
+}
+
+APOLLO_TEST(driverSlewLimitsEachCall) {
+  sim::reset();
+  Tank tank = makeTank();
+  tank.setDriverSlew(0.25);
+  setStick(127, 0);
+  for (int call = 1; call <= 5; call++) {
+    tank.setArcade(E_CONTROLLER_ANALOG_LEFT_Y, E_CONTROLLER_ANALOG_RIGHT_X,
+                   nullptr);
+    double expected = 3000.0 * std::fmin(call, 4);
+    CHECK_NEAR(sim::motor(1).voltage, expected, 1);
+    CHECK_NEAR(sim::motor(3).voltage, expected, 1);
+  }
+  // Letting go comes down at the same rate, and no slew jumps straight
+  // to the stick.
+  setStick(0, 0);
+  tank.setArcade(E_CONTROLLER_ANALOG_LEFT_Y, E_CONTROLLER_ANALOG_RIGHT_X,
+                 nullptr);
+  CHECK_NEAR(sim::motor(1).voltage, 9000, 1);
+  tank.setDriverSlew(0);
+  tank.setArcade(E_CONTROLLER_ANALOG_LEFT_Y, E_CONTROLLER_ANALOG_RIGHT_X,
+                 nullptr);
+  CHECK(sim::motor(1).voltage == 0);
+}
+
+APOLLO_TEST(arcadeMixesForwardAndTurn) {
+  sim::reset();
+  Tank tank = makeTank();
+  // Half forward and a quarter turn right add on the left side.
+  setStick(64, 32);
+  tank.setArcade(E_CONTROLLER_ANALOG_LEFT_Y, E_CONTROLLER_ANALOG_RIGHT_X,
+                 nullptr);
+  CHECK_NEAR(sim::motor(1).voltage, 12000 * 96 / 127.0, 1);
+  CHECK_NEAR(sim::motor(2).voltage, 12000 * 96 / 127.0, 1);
+  CHECK_NEAR(sim::motor(3).voltage, 12000 * 32 / 127.0, 1);
+  CHECK_NEAR(sim::motor(4).voltage, 12000 * 32 / 127.0, 1);
+  // Full forward and half turn left asks the right side for 1.5; both
+  // sides scale down together so the turn is kept.
+  setStick(127, -64);
+  tank.setArcade(E_CONTROLLER_ANALOG_LEFT_Y, E_CONTROLLER_ANALOG_RIGHT_X,
+                 nullptr);
+  double turn = 64 / 127.0;
+  CHECK_NEAR(sim::motor(1).voltage, 12000 * (1 - turn) / (1 + turn), 1);
+  CHECK_NEAR(sim::motor(3).voltage, 12000, 1);
+  // The turn curve shapes only the turn axis.
+  tank.setTurnCurve(turnDeadband);
+  setStick(64, 32);
+  tank.setArcade(E_CONTROLLER_ANALOG_LEFT_Y, E_CONTROLLER_ANALOG_RIGHT_X,
+                 nullptr);
+  CHECK_NEAR(sim::motor(1).voltage, 12000 * 64 / 127.0, 1);
+  CHECK_NEAR(sim::motor(3).voltage, 12000 * 64 / 127.0, 1);
+}
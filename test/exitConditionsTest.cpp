@@ -0,0 +1,118 @@
+#include <functional>
+
+#include "apollo/chassis/motion.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+namespace {
+// A binary fraction of a second, so window times add up exactly.
+constexpr double tickSeconds = 1.0 / 64;
+constexpr double startSeconds = 2;
+
+// Reports a scripted error each tick and nothing else.
+class ScriptedMotion : public Motion {
+ public:
+  ScriptedMotion(const ExitConditions& conditions, QTime expected) {
+    setExitConditions(conditions);
+    expectedDuration = expected;
+  }
+  DriveOutput step(const MotionContext& context) override {
+    updateSettled(error, context);
+    return {};
+  }
+  double error = 0;
+};
+
+// Runs the motion until it settles or maxTicks pass. script sets the
+// error and the frame for each tick.
+std::shared_ptr<MotionState> run(
+    const ExitConditions& conditions, int maxTicks,
+    const std::function<void(int, double&, SensorFrame&)>& script,
+    QTime expectedDuration = QTime()) {
+  ScriptedMotion motion(conditions, expectedDuration);
+  SensorFrame frame;
+  frame.leftMotorCount = 2;
+  frame.rightMotorCount = 2;
+  for (int tick = 0; tick < maxTicks && !motion.getState()->settled;
+       tick++) {
+    script(tick, motion.error, frame);
+    MotionContext context{frame, {}, {}, {}, {}, {},
+                          (startSeconds + tick * tickSeconds) * second};
+    if (tick == 0) {
+      motion.start(context);
+    }
+    motion.step(context);
+  }
+  return motion.getState();
+}
+
+void setMotors(SensorFrame& frame, double current, QAngularSpeed velocity) {
+  for (std::size_t i = 0; i < 2; i++) {
+    frame.leftMotors[i].current = current;
+    frame.leftMotors[i].velocity = velocity;
+    frame.rightMotors[i].current = current;
+    frame.rightMotors[i].velocity = velocity;
+  }
+}
+}  // namespace
+
+APOLLO_TEST(largeErrorExitsAfterItsDwell) {
+  ExitConditions conditions;
+  conditions.largeError = 0.05;
+  conditions.largeErrorTime = 0.25 * second;
+  // Outside the window for 4 ticks, then parked inside it.
+  auto state = run(conditions, 200, [](int tick, double& error, SensorFrame&) {
+    error = tick < 4 ? 0.1 : 0.03;
+  });
+  CHECK(state->reason == exit_large_error);
+  CHECK_NEAR(state->exitTime, (4 + 16) * tickSeconds, 1e-12);
+}
+
+APOLLO_TEST(velocityExitsOnceTheErrorStopsChanging) {
+  ExitConditions conditions;
+  conditions.largeError = 0.05;
+  conditions.minVelocity = 0.01;
+  conditions.velocityTime = 0.125 * second;
+  // Closing in, then stopped short inside the large window.
+  auto state = run(conditions, 200, [](int tick, double& error, SensorFrame&) {
+    error = tick < 10 ? 0.2 - 0.015 * tick : 0.04;
+  });
+  CHECK(state->reason == exit_velocity);
+  // Tick 10 still moved into the window, tick 11 is the first still one.
+  CHECK_NEAR(state->exitTime, (11 + 8) * tickSeconds, 1e-12);
+}
+
+APOLLO_TEST(stallNeedsCurrentAndNoSpeed) {
+  ExitConditions conditions;
+  conditions.stallCurrent = 2000;
+  conditions.stallVelocity = 5 * rpm;
+  conditions.stallTime = 0.25 * second;
+  // Pushing hard while moving, then pinned against a wall from tick 10.
+  auto state = run(conditions, 200,
+                   [](int tick, double& error, SensorFrame& frame) {
+                     error = 0.5;
+                     setMotors(frame, 2500, (tick < 10 ? 100 : 2) * rpm);
+                   });
+  CHECK(state->reason == exit_stall);
+  CHECK_NEAR(state->exitTime, (10 + 16) * tickSeconds, 1e-12);
+  // Stopped but not pushing is not a stall.
+  state = run(conditions, 200, [](int, double& error, SensorFrame& frame) {
+    error = 0.5;
+    setMotors(frame, 500, 0 * rpm);
+  });
+  CHECK(!state->settled);
+  CHECK(state->reason == exit_none);
+}
+
+APOLLO_TEST(timeoutStartsAfterTheExpectedDuration) {
+  ExitConditions conditions;
+  conditions.timeout = 1 * second;
+  auto never = [](int, double& error, SensorFrame&) { error = 0.5; };
+  auto state = run(conditions, 500, never);
+  CHECK(state->reason == exit_timeout);
+  CHECK_NEAR(state->exitTime, 1, 1e-12);
+  state = run(conditions, 500, never, 0.5 * second);
+  CHECK(state->reason == exit_timeout);
+  CHECK_NEAR(state->exitTime, 1.5, 1e-12);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+#include "apollo/chassis/chassis.hpp"
+#include "apollo/util/clock.hpp"
+
+namespace apollo::test {
+// Chassis whose update() only counts ticks and, when given a ManualClock,
+// spends a fixed amount of simulated time so loop timing can be checked.
+class FakeChassis : public Chassis {
+ public:
+  explicit FakeChassis(util::ManualClock* clock = nullptr) : clock(clock) {}
+  void update() override {
+    if (clock) {
+      clock->advance(updateTime);
+    }
+    updates++;
+  }
+  void resetSensors() override {}
+  void setBrakeMode(motor_brake_mode_e_t) override {}
+  void setGearing(double) override {}
+  void setEncoderUnits(double) override {}
+  void setMaxVelocity(double) override {}
+  void setMaxVoltage(double) override {}
+  MotionHandle setDrivePID(QLength, QSpeed) override { return {}; }
+  MotionHandle setTurnPID(QAngle, QAngularSpeed) override { return {}; }
+  MotionHandle setSwingPID(direction, QAngle, QAngularSpeed) override {
+    return {};
+  }
+  void setTank(controller_analog_e_t, controller_analog_e_t,
+               controller_analog_e_t*) override {}
+  void setArcade(controller_analog_e_t, controller_analog_e_t,
+                 controller_analog_e_t*) override {}
+  motor_brake_mode_e_t getBrakeMode() const override {
+    return E_MOTOR_BRAKE_COAST;
+  }
+  double getGearing() const override { return 1; }
+  double getEncoderUnits() const override { return 0; }
+  double getMaxVelocity() const override { return 0; }
+  double getMaxVoltage() const override { return 12000; }
+
+  util::ManualClock* clock;
+  std::uint64_t updateTime = 0;
+  std::atomic<std::uint32_t> updates{0};
+};
+}  // namespace apollo::test
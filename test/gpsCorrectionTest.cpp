@@ -0,0 +1,116 @@
+#include <cmath>
+#include <random>
+
+#include "apollo/chassis/gpsCorrection.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr int tickMilliseconds = 10;
+// The sensor publishes a new fix every few control ticks and the control
+// loop reads the same fix in between.
+constexpr int ticksPerFix = 5;
+
+Pose odometryAt(int tick, double drift) {
+  // Driving along x at 0.5 m/s, with odometry over-reading by `drift`.
+  double x = 0.5 * tick * tickMilliseconds / 1000.0;
+  return {x * (1 + drift) * meter, 0 * meter, 0 * degree,
+          tick * tickMilliseconds * millisecond};
+}
+}  // namespace
+
+APOLLO_TEST(fusesEachFixOnce) {
+  GpsCorrection correction;
+  std::mt19937 random(3);
+  std::normal_distribution<double> gpsNoise(0, 0.01);
+  int accepted = 0;
+  int repeated = 0;
+  GpsSample fix;
+  for (int tick = 0; tick < 500; tick++) {
+    correction.recordPose(odometryAt(tick, 0.05));
+    if (tick % ticksPerFix == 0) {
+      // The fix describes where the robot was one latency ago.
+      int takenAt = std::max(tick - 4, 0);
+      fix = {(0.5 * takenAt * tickMilliseconds / 1000.0 + gpsNoise(random)) *
+                 meter,
+             gpsNoise(random) * meter, 1 * centimeter,
+             tick * tickMilliseconds * millisecond};
+    }
+    GpsCorrection::sampleResult result = correction.addSample(fix);
+    if (result == GpsCorrection::sample_accepted) {
+      accepted++;
+    } else if (result == GpsCorrection::sample_repeated) {
+      repeated++;
+    }
+  }
+  CHECK(accepted + repeated == 500);
+  CHECK(accepted <= 500 / ticksPerFix);
+  CHECK(repeated == 500 - 500 / ticksPerFix);
+  // After 2.5 m the corrected pose sits close to the truth even though
+  // odometry is 12.5 cm ahead.
+  Pose corrected = correction.apply(odometryAt(499, 0.05));
+  double truth = 0.5 * 499 * tickMilliseconds / 1000.0;
+  CHECK_NEAR(corrected.x.convert(meter), truth, 0.03);
+  CHECK_NEAR(corrected.y.convert(meter), 0, 0.03);
+}
+
+APOLLO_TEST(repeatedReadingsDoNotShrinkTheVariance) {
+  GpsCorrection once;
+  GpsCorrection repeatedly;
+  for (int tick = 0; tick < 10; tick++) {
+    once.recordPose(odometryAt(tick, 0));
+    repeatedly.recordPose(odometryAt(tick, 0));
+  }
+  GpsSample fix{0.1 * meter, 0.02 * meter, 1 * centimeter,
+                90 * millisecond};
+  CHECK(once.addSample(fix) == GpsCorrection::sample_accepted);
+  for (int read = 0; read < 10; read++) {
+    repeatedly.addSample(fix);
+  }
+  CHECK_NEAR(repeatedly.getOffsetX().convert(meter),
+             once.getOffsetX().convert(meter), 1e-12);
+  CHECK_NEAR(repeatedly.getOffsetY().convert(meter),
+             once.getOffsetY().convert(meter), 1e-12);
+}
+
+APOLLO_TEST(identicalFixesOnePeriodApartAreBothFused) {
+  GpsCorrection correction;
+  int accepted = 0;
+  int repeated = 0;
+  int noHistory = 0;
+  // Standing still, read every 10 ms: the sensor publishes a new, identical
+  // fix every other read.
+  for (int tick = 0; tick < 30; tick++) {
+    QTime now = tick * tickMilliseconds * millisecond;
+    correction.recordPose({0.1 * meter, 0 * meter, 0 * degree, now});
+    GpsCorrection::sampleResult result =
+        correction.addSample({0.1 * meter, 0 * meter, 1 * centimeter, now});
+    if (result == GpsCorrection::sample_accepted) {
+      accepted++;
+    } else if (result == GpsCorrection::sample_repeated) {
+      repeated++;
+    } else if (result == GpsCorrection::sample_rejected_no_history) {
+      noHistory++;
+    }
+  }
+  // Every even read is a new fix, fused once the history covers the
+  // latency.
+  CHECK(repeated == 15);
+  CHECK(accepted + noHistory == 15);
+  CHECK(accepted >= 12);
+}
+
+APOLLO_TEST(rejectsOutliersAndNoisyFixes) {
+  GpsCorrection correction;
+  for (int tick = 0; tick < 10; tick++) {
+    correction.recordPose(odometryAt(tick, 0));
+  }
+  CHECK(correction.addSample({0.05 * meter, 0 * meter, 20 * centimeter,
+                              90 * millisecond}) ==
+        GpsCorrection::sample_rejected_error);
+  CHECK(correction.addSample({2 * meter, 0 * meter, 1 * centimeter,
+                              90 * millisecond}) ==
+        GpsCorrection::sample_rejected_outlier);
+  CHECK_NEAR(correction.getOffsetX().convert(meter), 0, 1e-12);
+}
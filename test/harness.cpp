@@ -0,0 +1,42 @@
+#include "harness.hpp"
+
+#include <vector>
+
+namespace apollo::test {
+namespace {
+struct Test {
+  const char* name;
+  void (*function)();
+};
+std::vector<Test>& tests() {
+  static std::vector<Test> registered;
+  return registered;
+}
+int testFailures = 0;
+}  // namespace
+
+void registerTest(const char* name, void (*function)()) {
+  tests().push_back({name, function});
+}
+void fail(const char* file, int line, const char* message) {
+  std::printf("  %s:%d: %s\n", file, line, message);
+  testFailures++;
+}
+}  // namespace apollo::test
+
+int main() {
+  using namespace apollo::test;
+  int failedTests = 0;
+  for (const Test& test : tests()) {
+    int failuresBefore = testFailures;
+    std::printf("[ RUN  ] %s\n", test.name);
+    test.function();
+    bool passed = testFailures == failuresBefore;
+    std::printf("[ %s ] %s\n", passed ? " OK " : "FAIL", test.name);
+    if (!passed) {
+      failedTests++;
+    }
+  }
+  std::printf("%zu tests, %d failed\n", tests().size(), failedTests);
+  return failedTests == 0 ? 0 : 1;
+}
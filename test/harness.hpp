@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+// Minimal host test runner. Every test file builds into its own executable
+// linked with harness.cpp, which runs the tests registered with APOLLO_TEST
+// and exits non-zero if any check failed.
+namespace apollo::test {
+void registerTest(const char* name, void (*function)());
+void fail(const char* file, int line, const char* message);
+
+// Keeps the optimizer from dropping a benchmarked result.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Mean wall time of one call, after a short warm up.
+template <typename Function>
+double nanosecondsPerCall(Function&& function, int iterations) {
+  for (int i = 0; i < iterations / 10 + 1; i++) {
+    function();
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    function();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         iterations;
+}
+}  // namespace apollo::test
+
+#define APOLLO_TEST(name)                            \
+  static void name();                                \
+  static const bool name##Registered =               \
+      (apollo::test::registerTest(#name, name), true); \
+  static void name()
+
+#define CHECK(condition)                                          \
+  do {                                                            \
+    if (!(condition)) {                                           \
+      apollo::test::fail(__FILE__, __LINE__, "CHECK(" #condition ")"); \
+    }                                                             \
+  } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                          \
+  do {                                                                   \
+    double checkActual = (actual);                                       \
+    double checkExpected = (expected);                                   \
+    if (!(checkActual - checkExpected <= (tolerance) &&                  \
+          checkExpected - checkActual <= (tolerance))) {                 \
+      char checkMessage[256];                                            \
+      std::snprintf(checkMessage, sizeof(checkMessage),                  \
+                    "CHECK_NEAR(" #actual ", " #expected "): %g vs %g",  \
+                    checkActual, checkExpected);                         \
+      apollo::test::fail(__FILE__, __LINE__, checkMessage);              \
+    }                                                                    \
+  } while (0)
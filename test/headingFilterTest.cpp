@@ -0,0 +1,66 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+#include "apollo/chassis/headingFilter.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+APOLLO_TEST(tracksAConstantTurnThroughNoise) {
+  std::mt19937 random(7);
+  std::normal_distribution<double> headingNoise(0, 2);
+  std::normal_distribution<double> rateNoise(0, 2);
+  HeadingFilter filter;
+  filter.reset(0 * degree);
+  constexpr double trueRate = 90;  // degrees per second
+  double worstError = 0;
+  for (int tick = 1; tick <= 300; tick++) {
+    double trueHeading = trueRate * tick * 0.01;
+    filter.predict(10 * millisecond);
+    filter.updateHeading((trueHeading + headingNoise(random)) * degree);
+    filter.updateGyroRate((trueRate + rateNoise(random)) * degree / second);
+    filter.updateWheelRate((trueRate + rateNoise(random)) * degree / second);
+    if (tick > 50) {
+      worstError = std::max(
+          worstError,
+          std::fabs(filter.getHeading().convert(degree) - trueHeading));
+    }
+  }
+  // Tighter than the 2 degree IMU noise once the filter has settled.
+  CHECK(worstError < 1.5);
+  CHECK_NEAR(filter.getRate().convert(degree / second), trueRate, 2);
+}
+
+APOLLO_TEST(rejectsWheelSlip) {
+  HeadingFilter filter;
+  filter.reset(0 * degree);
+  for (int tick = 0; tick < 50; tick++) {
+    filter.predict(10 * millisecond);
+    filter.updateHeading(0 * degree);
+    filter.updateGyroRate(0 * degree / second);
+    CHECK(filter.updateWheelRate(0 * degree / second));
+  }
+  // One wheel spins up while the robot stays put.
+  filter.predict(10 * millisecond);
+  CHECK(!filter.updateWheelRate(200 * degree / second));
+  CHECK_NEAR(filter.getRate().convert(degree / second), 0, 0.5);
+}
+
+APOLLO_TEST(tickCostIsBounded) {
+  HeadingFilter filter;
+  filter.reset(0 * degree);
+  double heading = 0;
+  double nanoseconds = test::nanosecondsPerCall(
+      [&] {
+        heading += 0.01;
+        filter.predict(10 * millisecond);
+        filter.updateHeading(heading * degree);
+        filter.updateGyroRate(1 * degree / second);
+        filter.updateWheelRate(1 * degree / second);
+      },
+      1000000);
+  test::doNotOptimize(filter.getHeading());
+  std::printf("  predict and three updates: %.1f ns\n", nanoseconds);
+  CHECK(nanoseconds < 2000);
+}
@@ -0,0 +1,140 @@
+#include <cmath>
+#include <cstdio>
+#include <type_traits>
+
+#include "apollo/chassis/holonomicKinematics.hpp"
+#include "apollo/chassis/mecanum.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr FourWheelKinematics mecanum =
+    mecanumKinematics(30 * centimeter, 25 * centimeter);
+constexpr FourWheelKinematics xDrive(M_SQRT1_2, 20 * centimeter);
+constexpr AsteriskKinematics asterisk(20 * centimeter, 15 * centimeter);
+constexpr HDriveKinematics hDrive(30 * centimeter);
+
+// Both directions are constant expressions over plain structs, so there
+// is nothing to allocate.
+static_assert(std::is_trivially_copyable_v<FourWheelVelocities>);
+static_assert(std::is_trivially_copyable_v<SixWheelVelocities>);
+static_assert(mecanum.forward(mecanum.inverse({1 * mps, 0 * mps, 0 * radps}))
+                  .forward.getValue() == 1);
+
+template <typename Kinematics>
+void checkRoundTrip(const Kinematics& kinematics) {
+  for (double forward : {-1.2, 0.0, 0.7}) {
+    for (double strafe : {-0.9, 0.0, 0.4}) {
+      for (double angular : {-3.0, 0.0, 1.5}) {
+        HolonomicSpeeds speeds{forward * mps, strafe * mps, angular * radps};
+        HolonomicSpeeds back = kinematics.forward(kinematics.inverse(speeds));
+        CHECK_NEAR(back.forward.convert(mps), forward, 1e-12);
+        CHECK_NEAR(back.strafe.convert(mps), strafe, 1e-12);
+        CHECK_NEAR(back.angular.convert(radps), angular, 1e-12);
+      }
+    }
+  }
+}
+
+double metersPerSecond(QSpeed speed) { return speed.convert(mps); }
+
+FourWheelVelocities desaturated(const FourWheelVelocities& wheels,
+                                QSpeed maxSpeed) {
+  return FourWheelKinematics::fromArray(
+      desaturate(FourWheelKinematics::toArray(wheels), maxSpeed));
+}
+}  // namespace
+
+APOLLO_TEST(inverseThenForwardRoundTrips) {
+  checkRoundTrip(mecanum);
+  checkRoundTrip(xDrive);
+  checkRoundTrip(asterisk);
+  checkRoundTrip(hDrive);
+}
+
+APOLLO_TEST(mecanumWheelDirections) {
+  // Pure strafe right: front left and back right forwards, the others
+  // backwards, all at the strafe speed.
+  FourWheelVelocities strafe = mecanum.inverse({0 * mps,
+                                                1 * mps,
+                                                0 * radps});
+  CHECK_NEAR(metersPerSecond(strafe.frontLeft), 1, 1e-12);
+  CHECK_NEAR(metersPerSecond(strafe.frontRight), -1, 1e-12);
+  CHECK_NEAR(metersPerSecond(strafe.backLeft), -1, 1e-12);
+  CHECK_NEAR(metersPerSecond(strafe.backRight), 1, 1e-12);
+  // Turning counter-clockwise at 1 rad/s moves every wheel by the sum of
+  // its half track width and half wheelbase.
+  FourWheelVelocities turn = mecanum.inverse({0 * mps,
+                                              0 * mps, 1 * radps});
+  CHECK_NEAR(metersPerSecond(turn.frontLeft), -0.275, 1e-12);
+  CHECK_NEAR(metersPerSecond(turn.backRight), 0.275, 1e-12);
+}
+
+APOLLO_TEST(desaturateKeepsTheDirection) {
+  HolonomicSpeeds speeds{1.5 * mps, 1 * mps, 2 * radps};
+  FourWheelVelocities limited = desaturated(mecanum.inverse(speeds), 1 * mps);
+  double peak = 0;
+  for (QSpeed wheel : FourWheelKinematics::toArray(limited)) {
+    peak = std::fmax(peak, std::fabs(metersPerSecond(wheel)));
+  }
+  CHECK_NEAR(peak, 1, 1e-12);
+  HolonomicSpeeds moved = mecanum.forward(limited);
+  double scale = metersPerSecond(moved.forward) / 1.5;
+  CHECK(scale < 1);
+  CHECK_NEAR(metersPerSecond(moved.strafe), 1 * scale, 1e-12);
+  CHECK_NEAR(moved.angular.convert(radps), 2 * scale, 1e-12);
+  // Already inside the limit, nothing changes.
+  FourWheelVelocities slow =
+      desaturated(mecanum.inverse({0.2 * mps, 0 * mps, 0 * radps}), 1 * mps);
+  CHECK_NEAR(metersPerSecond(slow.frontLeft), 0.2, 1e-12);
+}
+
+APOLLO_TEST(hDriveDesaturateHandlesZeroTopSpeeds) {
+  HDriveVelocities wheels{0.5 * mps, 1.5 * mps, 0.8 * mps};
+  HDriveVelocities limited = desaturate(wheels, 1 * mps, 1 * mps);
+  CHECK_NEAR(metersPerSecond(limited.right), 1, 1e-12);
+  CHECK_NEAR(metersPerSecond(limited.strafe), 0.8 / 1.5, 1e-12);
+  // A strafe wheel with no top speed can't follow, so nothing moves.
+  HDriveVelocities stopped = desaturate(wheels, 1 * mps, 0 * mps);
+  CHECK(stopped.left == 0 * mps);
+  CHECK(stopped.right == 0 * mps);
+  CHECK(stopped.strafe == 0 * mps);
+  // Not asking it to move leaves the sides alone.
+  HDriveVelocities sides =
+      desaturate({0.5 * mps, 0.6 * mps, 0 * mps}, 1 * mps, 0 * mps);
+  CHECK_NEAR(metersPerSecond(sides.left), 0.5, 1e-12);
+  CHECK_NEAR(metersPerSecond(sides.right), 0.6, 1e-12);
+  CHECK(sides.strafe == 0 * mps);
+}
+
+APOLLO_TEST(fieldCentricCommandsFollowTheHeading) {
+  // Facing 90 degrees counter-clockwise, field forward is to the robot's
+  // right.
+  HolonomicSpeeds field{1 * mps, 0 * mps, 0.5 * radps};
+  HolonomicSpeeds robot = toRobotFrame(field, 90 * degree);
+  CHECK_NEAR(metersPerSecond(robot.forward), 0, 1e-12);
+  CHECK_NEAR(metersPerSecond(robot.strafe), 1, 1e-12);
+  CHECK_NEAR(robot.angular.convert(radps), 0.5, 1e-12);
+  // Rotating back recovers the command.
+  HolonomicSpeeds again = toRobotFrame(robot, -90 * degree);
+  CHECK_NEAR(metersPerSecond(again.forward), 1, 1e-12);
+  CHECK_NEAR(metersPerSecond(again.strafe), 0, 1e-12);
+}
+
+APOLLO_TEST(kinematicsCost) {
+  HolonomicSpeeds speeds{0.5 * mps, 0.3 * mps, 1 * radps};
+  double sum = 0;
+  double nanoseconds = test::nanosecondsPerCall(
+      [&] {
+        speeds.forward = speeds.forward + 1e-9 * mps;
+        FourWheelVelocities wheels =
+            desaturated(mecanum.inverse(speeds), 1 * mps);
+        sum += metersPerSecond(mecanum.forward(wheels).forward);
+      },
+      1000000);
+  test::doNotOptimize(sum);
+  std::printf("  mecanum inverse, desaturate and forward: %.1f ns\n",
+              nanoseconds);
+  CHECK(nanoseconds < 500);
+}
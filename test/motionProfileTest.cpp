@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "apollo/chassis/motions.hpp"
+#include "apollo/control/motionProfile.hpp"
+#include "apollo/control/pidController.hpp"
+#include "apollo/control/profileCache.hpp"
+#include "harness.hpp"
+#include "tankSim.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr ProfileConstraints trapezoid{1 * mps, 2 * mps2, QJerk()};
+constexpr ProfileConstraints sCurve{1 * mps, 2 * mps2, 10 * mps2 / second};
+
+// Checks the profile stays inside its limits, that its position is the
+// integral of its velocity and that it ends at rest on the distance.
+void checkProfile(const MotionProfile& profile,
+                  const ProfileConstraints& constraints, double distance) {
+  double dt = 0.001;
+  double duration = profile.getDuration().convert(second);
+  double integrated = 0;
+  ProfileSetpoint last = profile.sample(0 * second);
+  for (double t = dt; t <= duration; t += dt) {
+    ProfileSetpoint setpoint = profile.sample(t * second);
+    CHECK(std::fabs(setpoint.velocity.convert(mps)) <=
+          constraints.maxVelocity.convert(mps) + 1e-9);
+    CHECK(std::fabs(setpoint.acceleration.convert(mps2)) <=
+          constraints.maxAcceleration.convert(mps2) + 1e-9);
+    integrated += (last.velocity + setpoint.velocity).convert(mps) / 2 * dt;
+    last = setpoint;
+  }
+  ProfileSetpoint end = profile.sample(profile.getDuration());
+  CHECK_NEAR(end.position.convert(meter), distance, 1e-9);
+  CHECK_NEAR(end.velocity.convert(mps), 0, 1e-9);
+  CHECK_NEAR(integrated, distance, 2e-3);
+}
+}  // namespace
+
+APOLLO_TEST(trapezoidalProfileRespectsItsLimits) {
+  MotionProfile profile(2 * meter, trapezoid);
+  checkProfile(profile, trapezoid, 2);
+  // 0.5 s up, 1.5 s at speed, 0.5 s down.
+  CHECK_NEAR(profile.getDuration().convert(second), 2.5, 1e-9);
+  CHECK_NEAR(profile.sample(1 * second).velocity.convert(mps), 1, 1e-9);
+}
+
+APOLLO_TEST(shortMovesNeverReachTopSpeed) {
+  MotionProfile profile(0.2 * meter, trapezoid);
+  checkProfile(profile, trapezoid, 0.2);
+  double peak = profile.sample(profile.getDuration() / 2).velocity.convert(mps);
+  CHECK_NEAR(peak, std::sqrt(2 * 0.1 * 2), 1e-9);
+}
+
+APOLLO_TEST(sCurveLimitsJerk) {
+  MotionProfile profile(-1.5 * meter, sCurve);
+  checkProfile(profile, sCurve, -1.5);
+  double dt = 0.001;
+  double worstJerk = 0;
+  for (double t = dt; t < profile.getDuration().convert(second); t += dt) {
+    double change = (profile.sample(t * second).acceleration -
+                     profile.sample((t - dt) * second).acceleration)
+                        .convert(mps2);
+    worstJerk = std::max(worstJerk, std::fabs(change) / dt);
+  }
+  CHECK(worstJerk <= 10 + 1e-6);
+}
+
+APOLLO_TEST(cacheReusesIdenticalMoves) {
+  ProfileCache<2> cache;
+  const MotionProfile* first = &cache.get(1 * meter, trapezoid);
+  CHECK(&cache.get(1 * meter, trapezoid) == first);
+  CHECK(cache.size() == 1);
+  cache.get(1 * meter, sCurve);
+  cache.get(2 * meter, trapezoid);
+  CHECK(cache.size() == 2);
+}
+
+APOLLO_TEST(rateFormDoesNotFightAMovingSetpoint) {
+  // The measurement follows the setpoint exactly at 1 m/s.
+  PIDGains gains{0, 0, 5};
+  PIDController<QLength> onMeasurement(gains);
+  PIDController<QLength> onTrackingError(gains);
+  for (int tick = 0; tick < 10; tick++) {
+    QLength position = tick * 0.01 * meter;
+    onMeasurement.step(position, position, 10 * millisecond);
+    double output = onTrackingError
+                        .step(position, position, 1 * mps, 1 * mps,
+                              10 * millisecond)
+                        .getValue();
+    CHECK_NEAR(output, 0, 1e-12);
+  }
+  CHECK_NEAR(onMeasurement.step(0.1 * meter, 0.1 * meter, 10 * millisecond)
+                 .getValue(),
+             -5, 1e-9);
+}
+
+APOLLO_TEST(driveTracksItsProfile) {
+  test::TankSim sim;
+  // The sim's exact model: 8000 mV per m/s, and its 50 ms lag as kA.
+  Feedforward feedforward(FeedforwardGains{0, 8000, 400});
+  MotionProfile profile(1.5 * meter, trapezoid);
+  DriveMotion motion(profile, 12000, PIDGains{20000, 0, 2000},
+                     PIDGains{20000, 0, 0}, feedforward);
+  motion.start(sim.context());
+  double worstError = 0;
+  while (!motion.getState()->settled && sim.time < 5) {
+    DriveOutput output = motion.step(sim.context());
+    sim.step(output);
+    double expected = profile.sample(sim.time * second).position.convert(meter);
+    worstError = std::max(worstError,
+                          std::fabs(expected - (sim.leftDistance +
+                                                sim.rightDistance) / 2));
+  }
+  CHECK(motion.getState()->reason == exit_small_error);
+  std::printf("  worst tracking error: %.2f mm\n", worstError * 1000);
+  CHECK(worstError < 0.01);
+  CHECK_NEAR(sim.x, 1.5, 0.0127);
+}
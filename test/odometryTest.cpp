@@ -0,0 +1,124 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "apollo/chassis/odometry.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr double trackerOffset = 5;  // inches either side of center
+constexpr double centerOffset = 2;   // inches behind center
+
+struct TrackerSample {
+  double left;
+  double right;
+  double center;
+};
+
+// Tracker readings for a robot driving a counter-clockwise arc of the given
+// radius, in `steps` equal increments. The perpendicular tracker sits
+// behind the center, so turning sweeps it to the right.
+std::vector<TrackerSample> arcReplay(double radius, double angle, int steps) {
+  std::vector<TrackerSample> samples;
+  for (int i = 0; i <= steps; i++) {
+    double theta = angle * i / steps;
+    samples.push_back({theta * (radius - trackerOffset),
+                       theta * (radius + trackerOffset),
+                       -theta * centerOffset});
+  }
+  return samples;
+}
+
+Odometry makeOdometry() {
+  return Odometry({trackerOffset * inch, trackerOffset * inch,
+                   centerOffset * inch});
+}
+
+void replay(Odometry& odometry, const std::vector<TrackerSample>& samples) {
+  for (std::size_t i = 0; i < samples.size(); i++) {
+    odometry.update(samples[i].left * inch, samples[i].right * inch,
+                    samples[i].center * inch, i * 10 * millisecond);
+  }
+}
+}  // namespace
+
+APOLLO_TEST(drivesStraight) {
+  Odometry odometry = makeOdometry();
+  replay(odometry, {{0, 0, 0}, {12, 12, 0}, {24, 24, 0}});
+  CHECK_NEAR(odometry.getX().convert(inch), 24, 1e-9);
+  CHECK_NEAR(odometry.getY().convert(inch), 0, 1e-9);
+  CHECK_NEAR(odometry.getTheta().convert(degree), 0, 1e-9);
+}
+
+APOLLO_TEST(turnsInPlace) {
+  Odometry odometry = makeOdometry();
+  replay(odometry, arcReplay(0, M_PI / 2, 50));
+  CHECK_NEAR(odometry.getX().convert(inch), 0, 1e-9);
+  CHECK_NEAR(odometry.getY().convert(inch), 0, 1e-9);
+  CHECK_NEAR(odometry.getTheta().convert(degree), 90, 1e-9);
+}
+
+APOLLO_TEST(followsAnArcExactly) {
+  // Arc integration is exact for constant curvature, however coarse the
+  // steps are.
+  for (int steps : {1, 4, 100}) {
+    Odometry odometry = makeOdometry();
+    replay(odometry, arcReplay(30, M_PI / 2, steps));
+    CHECK_NEAR(odometry.getX().convert(inch), 30, 1e-9);
+    CHECK_NEAR(odometry.getY().convert(inch), 30, 1e-9);
+    CHECK_NEAR(odometry.getTheta().convert(degree), 90, 1e-9);
+  }
+}
+
+APOLLO_TEST(strafesWithTheCenterTracker) {
+  Odometry odometry = makeOdometry();
+  odometry.setPose({0 * inch, 0 * inch, 90 * degree, 0 * second});
+  replay(odometry, {{0, 0, 0}, {0, 0, 6}});
+  // Moving left while facing +y is moving towards -x.
+  CHECK_NEAR(odometry.getX().convert(inch), -6, 1e-9);
+  CHECK_NEAR(odometry.getY().convert(inch), 0, 1e-9);
+}
+
+APOLLO_TEST(absoluteHeadingOverridesTrackerRotation) {
+  Odometry odometry = makeOdometry();
+  odometry.update(0 * inch, 0 * inch, 0 * inch, 0 * degree, 0 * second);
+  // The trackers disagree (wheel slip) but the IMU says no rotation.
+  odometry.update(10 * inch, 14 * inch, 0 * inch, 0 * degree,
+                  10 * millisecond);
+  CHECK_NEAR(odometry.getX().convert(inch), 12, 1e-9);
+  CHECK_NEAR(odometry.getTheta().convert(degree), 0, 1e-9);
+}
+
+APOLLO_TEST(updateFitsTheTickBudget) {
+  // Replays a one minute, 100 Hz trace of weaving arcs and checks the mean
+  // update cost. The budget is loose for a desktop and leaves room for the
+  // slower brain; the figure printed is what to compare between changes.
+  constexpr double budgetMicroseconds = 2;
+  std::vector<TrackerSample> samples;
+  double left = 0;
+  double right = 0;
+  double center = 0;
+  for (int i = 0; i < 6000; i++) {
+    double weave = std::sin(i * 0.01);
+    left += 0.5 - 0.2 * weave;
+    right += 0.5 + 0.2 * weave;
+    center += 0.01 * weave;
+    samples.push_back({left, right, center});
+  }
+  Odometry odometry = makeOdometry();
+  std::size_t index = 0;
+  double nanoseconds = test::nanosecondsPerCall(
+      [&] {
+        const TrackerSample& sample = samples[index];
+        odometry.update(sample.left * inch, sample.right * inch,
+                        sample.center * inch, index * 10 * millisecond);
+        index = (index + 1) % samples.size();
+      },
+      600000);
+  test::doNotOptimize(odometry.getPose());
+  std::printf("  odometry update: %.1f ns\n", nanoseconds);
+  CHECK(nanoseconds < budgetMicroseconds * 1000);
+  CHECK(std::isfinite(odometry.getX().convert(inch)));
+}
@@ -0,0 +1,121 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "apollo/control/pidController.hpp"
+#include "apollo/units/QLength.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr PIDGains gains{2.5, 0.8, 0.15, 1.2, 0.4};
+
+// The loop PIDController is meant to compile down to, on plain doubles.
+struct HandWrittenPID {
+  double integral = 0;
+  double lastMeasurement = 0;
+  double lastDerivative = 0;
+  bool firstStep = true;
+
+  double step(double setpoint, double measurement, double dt) {
+    double error = setpoint - measurement;
+    double derivative = 0;
+    if (!firstStep && dt > 0) {
+      derivative = gains.derivativeFilter * lastDerivative +
+                   (1 - gains.derivativeFilter) *
+                       (-(measurement - lastMeasurement) / dt);
+    }
+    integral += error * dt;
+    double integralTerm = gains.kI * integral;
+    if (integralTerm > gains.integralLimit) {
+      integralTerm = gains.integralLimit;
+      integral = integralTerm / gains.kI;
+    } else if (integralTerm < -gains.integralLimit) {
+      integralTerm = -gains.integralLimit;
+      integral = integralTerm / gains.kI;
+    }
+    lastMeasurement = measurement;
+    lastDerivative = derivative;
+    firstStep = false;
+    return gains.kP * error + integralTerm + gains.kD * derivative;
+  }
+};
+
+struct Sample {
+  double setpoint;
+  double measurement;
+};
+std::vector<Sample> randomSamples() {
+  std::mt19937 random(11);
+  std::uniform_real_distribution<double> value(-2, 2);
+  std::vector<Sample> samples(4096);
+  for (Sample& sample : samples) {
+    sample = {value(random), value(random)};
+  }
+  return samples;
+}
+}  // namespace
+
+APOLLO_TEST(matchesTheHandWrittenLoop) {
+  PIDController<QLength> typed(gains);
+  HandWrittenPID plain;
+  for (const Sample& sample : randomSamples()) {
+    double typedOutput =
+        typed.step(sample.setpoint * meter, sample.measurement * meter,
+                   10 * millisecond)
+            .getValue();
+    double plainOutput = plain.step(sample.setpoint, sample.measurement, 0.01);
+    CHECK(typedOutput == plainOutput);
+  }
+}
+
+APOLLO_TEST(setpointStepsDoNotKickTheDerivative) {
+  PIDController<QLength> pid(PIDGains{0, 0, 1});
+  pid.step(0 * meter, 0 * meter, 10 * millisecond);
+  CHECK_NEAR(pid.step(1 * meter, 0 * meter, 10 * millisecond).getValue(), 0,
+             1e-12);
+  // Measurement moving up is damped.
+  CHECK_NEAR(pid.step(1 * meter, 0.1 * meter, 10 * millisecond).getValue(),
+             -10, 1e-9);
+}
+
+APOLLO_TEST(integralIsCapped) {
+  PIDController<QLength> pid(PIDGains{0, 1, 0, 0.5});
+  for (int i = 0; i < 1000; i++) {
+    pid.step(1 * meter, 0 * meter, 10 * millisecond);
+  }
+  CHECK_NEAR(pid.step(1 * meter, 0 * meter, 10 * millisecond).getValue(),
+             0.5, 1e-12);
+  // Without windup the term unwinds as soon as the error changes sign.
+  CHECK(pid.step(-1 * meter, 0 * meter, 10 * millisecond).getValue() < 0.5);
+}
+
+APOLLO_TEST(costsTheSameAsTheHandWrittenLoop) {
+  std::vector<Sample> samples = randomSamples();
+  PIDController<QLength> typed(gains);
+  HandWrittenPID plain;
+  std::size_t index = 0;
+  double output = 0;
+  double typedTime = test::nanosecondsPerCall(
+      [&] {
+        const Sample& sample = samples[index++ & 4095];
+        output += typed
+                      .step(sample.setpoint * meter,
+                            sample.measurement * meter, 10 * millisecond)
+                      .getValue();
+      },
+      2000000);
+  index = 0;
+  double plainTime = test::nanosecondsPerCall(
+      [&] {
+        const Sample& sample = samples[index++ & 4095];
+        output += plain.step(sample.setpoint, sample.measurement, 0.01);
+      },
+      2000000);
+  test::doNotOptimize(output);
+  std::printf("  PIDController: %.2f ns, hand written: %.2f ns\n", typedTime,
+              plainTime);
+  // Loose enough for timer noise; equal code gives a ratio near one.
+  CHECK(typedTime < plainTime * 1.5 + 1);
+}
@@ -0,0 +1,102 @@
+#include <cstdio>
+
+#include "apollo/chassis/poseHistory.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+namespace {
+// A pose moving 1 cm along x, 2 cm along y and 1 degree per ms.
+Pose poseAt(double milliseconds) {
+  return {milliseconds * centimeter, 2 * milliseconds * centimeter,
+          milliseconds * degree, milliseconds * millisecond};
+}
+
+template <std::size_t Capacity>
+void fill(PoseHistory<Capacity>& history, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) {
+    history.push(poseAt(10.0 * i));
+  }
+}
+
+// Mean cost of a lookup spread over the whole history.
+template <std::size_t Capacity>
+double lookupNanoseconds(const PoseHistory<Capacity>& history) {
+  double span = 10.0 * (Capacity - 1);
+  double query = 0;
+  Pose pose;
+  return test::nanosecondsPerCall(
+      [&] {
+        query += 0.37 * span;
+        if (query > span) {
+          query -= span;
+        }
+        history.sample(query * millisecond, pose);
+        test::doNotOptimize(pose);
+      },
+      1000000);
+}
+}  // namespace
+
+APOLLO_TEST(interpolatesBetweenEntries) {
+  PoseHistory<8> history;
+  fill(history, 3);
+  Pose pose;
+  CHECK(history.sample(15 * millisecond, pose));
+  CHECK_NEAR(pose.x.convert(centimeter), 15, 1e-9);
+  CHECK_NEAR(pose.y.convert(centimeter), 30, 1e-9);
+  CHECK_NEAR(pose.theta.convert(degree), 15, 1e-9);
+  CHECK_NEAR(pose.timestamp.convert(millisecond), 15, 1e-9);
+  // An exact timestamp gives that entry.
+  CHECK(history.sample(10 * millisecond, pose));
+  CHECK_NEAR(pose.x.convert(centimeter), 10, 1e-9);
+}
+
+APOLLO_TEST(clampsOutsideTheRange) {
+  PoseHistory<8> history;
+  Pose pose;
+  CHECK(!history.sample(0 * millisecond, pose));
+  fill(history, 3);
+  CHECK(history.sample(-5 * millisecond, pose));
+  CHECK_NEAR(pose.x.convert(centimeter), 0, 1e-9);
+  CHECK_NEAR(pose.timestamp.convert(millisecond), 0, 1e-9);
+  CHECK(history.sample(100 * millisecond, pose));
+  CHECK_NEAR(pose.x.convert(centimeter), 20, 1e-9);
+  CHECK_NEAR(pose.timestamp.convert(millisecond), 20, 1e-9);
+  // Pushing out of order is refused and leaves the history as it was.
+  CHECK(!history.push(poseAt(15)));
+  CHECK(history.size() == 3);
+}
+
+APOLLO_TEST(overwritesTheOldestAtCapacity) {
+  PoseHistory<4> history;
+  fill(history, 6);
+  CHECK(history.size() == 4);
+  CHECK_NEAR(history.oldest().timestamp.convert(millisecond), 20, 1e-9);
+  CHECK_NEAR(history.newest().timestamp.convert(millisecond), 50, 1e-9);
+  for (std::size_t i = 0; i < history.size(); i++) {
+    CHECK_NEAR(history[i].timestamp.convert(millisecond), 20 + 10.0 * i,
+               1e-9);
+  }
+  // Between entries stored on either side of the wrap in the ring.
+  Pose pose;
+  CHECK(history.sample(35 * millisecond, pose));
+  CHECK_NEAR(pose.x.convert(centimeter), 35, 1e-9);
+  // What fell off the end clamps to the new oldest entry.
+  CHECK(history.sample(5 * millisecond, pose));
+  CHECK_NEAR(pose.x.convert(centimeter), 20, 1e-9);
+}
+
+// A lookup in a history 64 times longer costs a few more binary search
+// steps, nowhere near 64 times as much.
+APOLLO_TEST(lookupIsLogarithmic) {
+  static PoseHistory<64> small;
+  static PoseHistory<4096> large;
+  fill(small, small.capacity());
+  fill(large, large.capacity());
+  double smallCost = lookupNanoseconds(small);
+  double largeCost = lookupNanoseconds(large);
+  std::printf("  lookup in 64 poses: %.1f ns, in 4096 poses: %.1f ns\n",
+              smallCost, largeCost);
+  CHECK(largeCost < 8 * smallCost);
+}
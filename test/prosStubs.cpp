@@ -0,0 +1,359 @@
+// Host implementations of the pros API Apollo uses, backed by the device
+// tables in simDevices. Tasks run on std::threads and mutexes on
+// std::timed_mutex so threaded code can be exercised off the brain.
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "pros/adi.hpp"
+#include "pros/error.h"
+#include "pros/gps.hpp"
+#include "pros/imu.hpp"
+#include "pros/misc.hpp"
+#include "pros/motors.hpp"
+#include "pros/rotation.hpp"
+#include "pros/rtos.hpp"
+#include "simDevices.hpp"
+
+namespace pros {
+namespace {
+struct SimTask {
+  std::atomic<bool> finished{false};
+  std::mutex notifyMutex;
+  std::condition_variable notified;
+  std::uint32_t notifyCount = 0;
+};
+thread_local SimTask* currentTask = nullptr;
+}  // namespace
+
+// Task handles are never freed, so a handle stays readable after its
+// thread has finished.
+Task::Task(task_fn_t function, void* parameters, std::uint32_t,
+           std::uint16_t, const char*) {
+  SimTask* simTask = new SimTask();
+  task = simTask;
+  std::thread([=] {
+    currentTask = simTask;
+    function(parameters);
+    simTask->finished = true;
+  }).detach();
+}
+Task::Task(task_t task) : task(task) {}
+Task Task::current() { return Task(static_cast<task_t>(currentTask)); }
+std::uint32_t Task::get_state() {
+  SimTask* simTask = static_cast<SimTask*>(task);
+  return simTask && simTask->finished ? E_TASK_STATE_DELETED
+                                      : E_TASK_STATE_RUNNING;
+}
+std::uint32_t Task::notify() {
+  SimTask* simTask = static_cast<SimTask*>(task);
+  std::lock_guard<std::mutex> lock(simTask->notifyMutex);
+  simTask->notifyCount++;
+  simTask->notified.notify_all();
+  return 1;
+}
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) {
+  SimTask* simTask = currentTask;
+  std::unique_lock<std::mutex> lock(simTask->notifyMutex);
+  auto notified = [simTask] { return simTask->notifyCount > 0; };
+  if (timeout == TIMEOUT_MAX) {
+    simTask->notified.wait(lock, notified);
+  } else {
+    simTask->notified.wait_for(lock, std::chrono::milliseconds(timeout),
+                               notified);
+  }
+  std::uint32_t count = simTask->notifyCount;
+  if (count > 0) {
+    simTask->notifyCount = clear_on_exit ? 0 : count - 1;
+  }
+  return count;
+}
+void Task::delay(const std::uint32_t milliseconds) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+void Task::delay_until(std::uint32_t* const prev_time,
+                       const std::uint32_t delta) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(delta));
+  *prev_time += delta;
+}
+
+Mutex::Mutex()
+    : mutex(new std::timed_mutex(),
+            [](void* mutex) { delete static_cast<std::timed_mutex*>(mutex); }) {
+}
+bool Mutex::take(std::uint32_t timeout) {
+  std::timed_mutex* handle = static_cast<std::timed_mutex*>(mutex.get());
+  if (timeout == TIMEOUT_MAX) {
+    handle->lock();
+    return true;
+  }
+  return handle->try_lock_for(std::chrono::milliseconds(timeout));
+}
+bool Mutex::give() {
+  static_cast<std::timed_mutex*>(mutex.get())->unlock();
+  return true;
+}
+
+Controller::Controller(controller_id_e_t id) : _id(id) {}
+
+ADIPort::ADIPort(std::uint8_t adi_port, adi_port_config_e_t)
+    : _smart_port(INTERNAL_ADI_PORT), _adi_port(adi_port) {}
+ADIPort::ADIPort(ext_adi_port_pair_t port_pair, adi_port_config_e_t)
+    : _smart_port(std::get<0>(port_pair)),
+      _adi_port(std::get<1>(port_pair)) {}
+ADIEncoder::ADIEncoder(std::uint8_t adi_port_top, std::uint8_t, bool)
+    : ADIPort(adi_port_top) {}
+ADIEncoder::ADIEncoder(ext_adi_port_tuple_t port_tuple, bool)
+    : ADIPort({std::get<0>(port_tuple), std::get<1>(port_tuple)}) {}
+// Unconfigured trackers sit on port -1; PROS fails those calls with
+// PROS_ERR rather than touching a device.
+std::int32_t ADIEncoder::reset() const {
+  if (_adi_port >= apollo::sim::portCount) {
+    return PROS_ERR;
+  }
+  apollo::sim::adiEncoder(_adi_port) = 0;
+  return 1;
+}
+std::int32_t ADIEncoder::get_value() const {
+  if (_adi_port >= apollo::sim::portCount) {
+    return PROS_ERR;
+  }
+  return apollo::sim::adiEncoder(_adi_port);
+}
+
+Motor::Motor(const std::int8_t port, const bool reverse) : _port(port) {
+  apollo::sim::motor(_port).reversed = reverse;
+}
+Rotation::Rotation(const std::uint8_t port, const bool) : _port(port) {}
+std::int32_t Motor::operator=(std::int32_t voltage) const {
+  return move(voltage);
+}
+std::int32_t Motor::move(std::int32_t voltage) const {
+  apollo::sim::motor(_port).voltage = voltage * 12000 / 127;
+  return 1;
+}
+std::int32_t Motor::move_absolute(const double position,
+                                  const std::int32_t velocity) const {
+  return {};
+}
+std::int32_t Motor::move_relative(const double position,
+                                  const std::int32_t velocity) const {
+  return {};
+}
+std::int32_t Motor::move_velocity(const std::int32_t velocity) const {
+  apollo::sim::motor(_port).velocityTarget = velocity;
+  return 1;
+}
+std::int32_t Motor::move_voltage(const std::int32_t voltage) const {
+  apollo::sim::motor(_port).voltage = voltage;
+  return 1;
+}
+std::int32_t Motor::brake(void) const { return {}; }
+std::int32_t Motor::modify_profiled_velocity(
+    const std::int32_t velocity) const {
+  return {};
+}
+double Motor::get_target_position(void) const { return {}; }
+std::int32_t Motor::get_target_velocity(void) const { return {}; }
+double Motor::get_actual_velocity(void) const {
+  const apollo::sim::MotorState& state = apollo::sim::motor(_port);
+  return state.unplugged ? PROS_ERR_F : state.velocity;
+}
+std::int32_t Motor::get_current_draw(void) const {
+  apollo::sim::MotorState& state = apollo::sim::motor(_port);
+  state.currentDrawReads++;
+  return state.unplugged ? PROS_ERR : state.currentDraw;
+}
+std::int32_t Motor::get_direction(void) const { return {}; }
+double Motor::get_efficiency(void) const { return {}; }
+std::int32_t Motor::is_over_current(void) const { return {}; }
+std::int32_t Motor::is_stopped(void) const { return {}; }
+std::int32_t Motor::get_zero_position_flag(void) const { return {}; }
+std::uint32_t Motor::get_faults(void) const { return {}; }
+std::uint32_t Motor::get_flags(void) const { return {}; }
+// Raw counts ignore set_reversed, like the motor's own encoder.
+std::int32_t Motor::get_raw_position(std::uint32_t* const timestamp) const {
+  const apollo::sim::MotorState& state = apollo::sim::motor(_port);
+  if (state.unplugged) {
+    return PROS_ERR;
+  }
+  if (timestamp) {
+    *timestamp = state.rawTimestamp;
+  }
+  double counts = state.position / 360 * state.countsPerRevolution;
+  return static_cast<std::int32_t>(std::lround(state.reversed ? -counts
+                                                               : counts));
+}
+std::int32_t Motor::is_over_temp(void) const { return {}; }
+double Motor::get_position(void) const {
+  const apollo::sim::MotorState& state = apollo::sim::motor(_port);
+  return state.unplugged ? PROS_ERR_F : state.position;
+}
+double Motor::get_power(void) const { return {}; }
+double Motor::get_temperature(void) const { return {}; }
+double Motor::get_torque(void) const { return {}; }
+std::int32_t Motor::get_voltage(void) const {
+  return apollo::sim::motor(_port).voltage;
+}
+std::int32_t Motor::set_zero_position(const double position) const {
+  return {};
+}
+std::int32_t Motor::tare_position(void) const {
+  apollo::sim::motor(_port).position = 0;
+  return 1;
+}
+std::int32_t Motor::set_brake_mode(const motor_brake_mode_e_t mode) const {
+  return {};
+}
+std::int32_t Motor::set_current_limit(const std::int32_t limit) const {
+  apollo::sim::MotorState& state = apollo::sim::motor(_port);
+  state.currentLimit = limit;
+  state.currentLimitWrites++;
+  return 1;
+}
+std::int32_t Motor::set_encoder_units(
+    const motor_encoder_units_e_t units) const {
+  return {};
+}
+std::int32_t Motor::set_gearing(const motor_gearset_e_t gearset) const {
+  return {};
+}
+std::int32_t Motor::set_pos_pid(const motor_pid_s_t pid) const { return {}; }
+std::int32_t Motor::set_pos_pid_full(const motor_pid_full_s_t pid) const {
+  return {};
+}
+std::int32_t Motor::set_vel_pid(const motor_pid_s_t pid) const { return {}; }
+std::int32_t Motor::set_vel_pid_full(const motor_pid_full_s_t pid) const {
+  return {};
+}
+std::int32_t Motor::set_reversed(const bool reverse) const {
+  apollo::sim::motor(_port).reversed = reverse;
+  return 1;
+}
+std::int32_t Motor::set_voltage_limit(const std::int32_t limit) const {
+  return {};
+}
+motor_brake_mode_e_t Motor::get_brake_mode(void) const { return {}; }
+std::int32_t Motor::get_current_limit(void) const {
+  return apollo::sim::motor(_port).currentLimit;
+}
+motor_encoder_units_e_t Motor::get_encoder_units(void) const { return {}; }
+motor_gearset_e_t Motor::get_gearing(void) const { return {}; }
+motor_pid_full_s_t Motor::get_pos_pid(void) const { return {}; }
+motor_pid_full_s_t Motor::get_vel_pid(void) const { return {}; }
+std::int32_t Motor::is_reversed(void) const {
+  return apollo::sim::motor(_port).reversed;
+}
+std::int32_t Motor::get_voltage_limit(void) const { return {}; }
+std::uint8_t Motor::get_port(void) const { return _port; }
+std::int32_t Imu::reset(bool blocking) const { return {}; }
+std::int32_t Imu::set_data_rate(std::uint32_t rate) const { return {}; }
+double Imu::get_rotation() const { return apollo::sim::imu(_port).rotation; }
+double Imu::get_heading() const { return apollo::sim::imu(_port).heading; }
+pros::c::quaternion_s_t Imu::get_quaternion() const { return {}; }
+pros::c::euler_s_t Imu::get_euler() const { return {}; }
+double Imu::get_pitch() const { return {}; }
+double Imu::get_roll() const { return {}; }
+double Imu::get_yaw() const { return {}; }
+pros::c::imu_gyro_s_t Imu::get_gyro_rate() const {
+  return {0, 0, apollo::sim::imu(_port).gyroZ};
+}
+std::int32_t Imu::tare_rotation() const { return {}; }
+std::int32_t Imu::tare_heading() const { return {}; }
+std::int32_t Imu::tare_pitch() const { return {}; }
+std::int32_t Imu::tare_yaw() const { return {}; }
+std::int32_t Imu::tare_roll() const { return {}; }
+std::int32_t Imu::tare() const {
+  apollo::sim::imu(_port).heading = 0;
+  apollo::sim::imu(_port).rotation = 0;
+  return 1;
+}
+std::int32_t Imu::tare_euler() const { return {}; }
+std::int32_t Imu::set_heading(const double target) const { return {}; }
+std::int32_t Imu::set_rotation(const double target) const { return {}; }
+std::int32_t Imu::set_yaw(const double target) const { return {}; }
+std::int32_t Imu::set_pitch(const double target) const { return {}; }
+std::int32_t Imu::set_roll(const double target) const { return {}; }
+std::int32_t Imu::set_euler(const pros::c::euler_s_t target) const {
+  return {};
+}
+pros::c::imu_accel_s_t Imu::get_accel() const {
+  const apollo::sim::ImuState& state = apollo::sim::imu(_port);
+  return {state.accelX, state.accelY, state.accelZ};
+}
+pros::c::imu_status_e_t Imu::get_status() const { return {}; }
+bool Imu::is_calibrating() const { return {}; }
+std::int32_t Rotation::reset() { return {}; }
+std::int32_t Rotation::set_data_rate(std::uint32_t rate) const { return {}; }
+std::int32_t Rotation::set_position(std::uint32_t position) { return {}; }
+std::int32_t Rotation::reset_position(void) {
+  if (_port >= apollo::sim::portCount) {
+    return PROS_ERR;
+  }
+  apollo::sim::rotation(_port) = 0;
+  return 1;
+}
+std::int32_t Rotation::get_position() {
+  if (_port >= apollo::sim::portCount) {
+    return PROS_ERR;
+  }
+  return apollo::sim::rotation(_port);
+}
+std::int32_t Rotation::get_velocity() { return {}; }
+std::int32_t Rotation::get_angle() { return {}; }
+std::int32_t Rotation::set_reversed(bool value) { return {}; }
+std::int32_t Rotation::reverse() { return {}; }
+std::int32_t Rotation::get_reversed() { return {}; }
+std::int32_t Gps::initialize_full(double xInitial, double yInitial,
+                                  double headingInitial, double xOffset,
+                                  double yOffset) const {
+  return {};
+}
+std::int32_t Gps::set_offset(double xOffset, double yOffset) const {
+  return {};
+}
+std::int32_t Gps::get_offset(double* xOffset, double* yOffset) const {
+  return {};
+}
+std::int32_t Gps::set_position(double xInitial, double yInitial,
+                               double headingInitial) const {
+  return {};
+}
+std::int32_t Gps::set_data_rate(std::uint32_t rate) const { return {}; }
+double Gps::get_error() const { return apollo::sim::gps(_port).error; }
+pros::c::gps_status_s_t Gps::get_status() const {
+  apollo::sim::GpsState& state = apollo::sim::gps(_port);
+  state.statusReads++;
+  return {state.x, state.y, 0, 0, state.heading};
+}
+double Gps::get_heading() const { return apollo::sim::gps(_port).heading; }
+double Gps::get_heading_raw() const { return {}; }
+double Gps::get_rotation() const { return {}; }
+std::int32_t Gps::set_rotation(double target) const { return {}; }
+std::int32_t Gps::tare_rotation() const { return {}; }
+pros::c::gps_gyro_s_t Gps::get_gyro_rate() const { return {}; }
+pros::c::gps_accel_s_t Gps::get_accel() const { return {}; }
+
+namespace c {
+uint32_t millis(void) {
+  return static_cast<uint32_t>(apollo::sim::now() / 1000);
+}
+uint64_t micros(void) { return apollo::sim::now(); }
+void delay(const uint32_t milliseconds) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
+int32_t controller_get_analog(controller_id_e_t,
+                              controller_analog_e_t channel) {
+  return apollo::sim::controllerAxis(channel);
+}
+int32_t gps_set_offset(uint8_t, double, double) { return 1; }
+int32_t gps_set_position(uint8_t, double, double, double) { return 1; }
+int32_t gps_initialize_full(uint8_t, double, double, double, double,
+                            double) {
+  return 1;
+}
+}  // namespace c
+}  // namespace pros
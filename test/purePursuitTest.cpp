@@ -0,0 +1,127 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "apollo/control/purePursuit.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+namespace {
+std::vector<Waypoint> straightPath(double length, double spacing) {
+  std::vector<Waypoint> path;
+  int points = static_cast<int>(length / spacing) + 1;
+  for (int i = 0; i < points; i++) {
+    path.push_back({i * spacing * meter, 0 * meter});
+  }
+  return path;
+}
+// A weaving path, so the benchmark sees real intersections on every tick.
+std::vector<Waypoint> weavingPath(int points, double spacing) {
+  std::vector<Waypoint> path;
+  for (int i = 0; i < points; i++) {
+    double x = i * spacing;
+    path.push_back({x * meter, 0.3 * std::sin(x) * meter});
+  }
+  return path;
+}
+Pose at(double x, double y, double thetaDegrees = 0) {
+  return {x * meter, y * meter, thetaDegrees * degree, 0 * second};
+}
+// The search moves at most a lookahead along the path per tick, so drive
+// there in ticks rather than jumping.
+void driveTo(PurePursuit& pursuit, double x, double y) {
+  for (double step = 0.1; step < x; step += 0.1) {
+    pursuit.update(at(step, y));
+  }
+}
+}  // namespace
+
+APOLLO_TEST(looksAheadAlongAStraightPath) {
+  PurePursuit pursuit(straightPath(3, 0.1), 0.5 * meter);
+  CHECK_NEAR(pursuit.update(at(0, 0)), 0, 1e-9);
+  CHECK_NEAR(pursuit.getLookaheadPoint().x.convert(meter), 0.5, 1e-9);
+  driveTo(pursuit, 1.23, 0);
+  pursuit.update(at(1.23, 0));
+  CHECK_NEAR(pursuit.getLookaheadPoint().x.convert(meter), 1.73, 1e-9);
+  CHECK_NEAR(pursuit.getTravelled().convert(meter), 1.23, 1e-9);
+}
+
+APOLLO_TEST(offThePathItSteersForwardsOntoIt) {
+  PurePursuit pursuit(straightPath(3, 0.1), 0.5 * meter);
+  pursuit.update(at(0, 0));
+  // A meter off the path: no intersection.
+  driveTo(pursuit, 1, -1);
+  double curvature = pursuit.update(at(1, -1));
+  Waypoint point = pursuit.getLookaheadPoint();
+  CHECK_NEAR(point.x.convert(meter), 1.5, 1e-9);
+  CHECK_NEAR(point.y.convert(meter), 0, 1e-9);
+  CHECK(curvature > 0);
+}
+
+APOLLO_TEST(windowEndStopsAtThePathEnd) {
+  PurePursuit pursuit(straightPath(1, 0.1), 0.5 * meter);
+  pursuit.update(at(0.8, -1));
+  CHECK_NEAR(pursuit.getLookaheadPoint().x.convert(meter), 1, 1e-9);
+  pursuit.update(at(0.9, 0));
+  CHECK(pursuit.isAtEnd());
+}
+
+APOLLO_TEST(keepsUpOnADensePath) {
+  // One millimeter between points: a fixed segment count window would
+  // cover only a few centimeters, far less than a fast robot moves.
+  PurePursuit pursuit(straightPath(10, 0.001), 0.4 * meter);
+  for (int tick = 1; tick <= 40; tick++) {
+    double x = tick * 0.2;
+    pursuit.update(at(x, 0.02));
+    CHECK_NEAR(pursuit.getTravelled().convert(meter), x, 1e-6);
+    CHECK_NEAR(pursuit.getLookaheadPoint().x.convert(meter),
+               std::min(x + std::sqrt(0.4 * 0.4 - 0.02 * 0.02), 10.0), 1e-6);
+  }
+}
+
+APOLLO_TEST(intersectionIsOneLookaheadAway) {
+  std::vector<Waypoint> path;
+  for (int i = 0; i <= 90; i++) {
+    double angle = i * M_PI / 180;
+    path.push_back({std::sin(angle) * meter, (1 - std::cos(angle)) * meter});
+  }
+  PurePursuit pursuit(path, 0.3 * meter);
+  for (int i = 0; i <= 60; i += 10) {
+    double angle = i * M_PI / 180;
+    double x = std::sin(angle);
+    double y = 1 - std::cos(angle);
+    double curvature = pursuit.update(at(x, y, i));
+    Waypoint point = pursuit.getLookaheadPoint();
+    CHECK_NEAR(std::hypot(point.x.convert(meter) - x,
+                          point.y.convert(meter) - y),
+               0.3, 1e-9);
+    // On a unit circle the arc to the lookahead point is the circle.
+    CHECK_NEAR(curvature, 1, 0.01);
+  }
+}
+
+APOLLO_TEST(tickCostIsFlatInPathLength) {
+  double costs[2];
+  int lengths[2] = {200, 20000};
+  for (int run = 0; run < 2; run++) {
+    constexpr double spacing = 0.01;
+    PurePursuit pursuit(weavingPath(lengths[run], spacing), 0.3 * meter);
+    double x = 0;
+    double curvature = 0;
+    costs[run] = test::nanosecondsPerCall(
+        [&] {
+          x += 0.005;
+          if (x > 1.5) {
+            x = 0;
+            pursuit.reset();
+          }
+          curvature += pursuit.update(at(x, 0.3 * std::sin(x)));
+        },
+        200000);
+    test::doNotOptimize(curvature);
+  }
+  std::printf("  update on %d points: %.1f ns, on %d points: %.1f ns\n",
+              lengths[0], costs[0], lengths[1], costs[1]);
+  CHECK(costs[1] < costs[0] * 2 + 50);
+}
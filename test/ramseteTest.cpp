@@ -0,0 +1,99 @@
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+#include "apollo/chassis/motions.hpp"
+#include "apollo/control/ramsete.hpp"
+#include "harness.hpp"
+#include "tankSim.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr TrajectoryConstraints constraints{1.2 * mps, 1.5 * mps2,
+                                            30 * centimeter};
+
+std::shared_ptr<const Trajectory> makeTrajectory() {
+  return std::make_shared<Trajectory>(
+      TrajectoryGenerator(constraints)
+          .generate(SplinePath({{0 * meter, 0 * meter, 0 * degree},
+                                {1.2 * meter, 0.8 * meter, 90 * degree},
+                                {0.4 * meter, 1.8 * meter, 180 * degree}})));
+}
+
+struct TrackingResult {
+  double finalError;
+  double lateError;  // worst error over the second half
+};
+
+TrackingResult track(RamseteController controller, double startY,
+                     double startTheta) {
+  std::shared_ptr<const Trajectory> trajectory = makeTrajectory();
+  test::TankSim sim;
+  sim.y = startY;
+  sim.theta = startTheta;
+  // The sim's exact model, so what is left is the controller's error.
+  TrajectoryMotion motion(trajectory, controller, constraints.trackWidth,
+                          Feedforward(FeedforwardGains{0, 8000, 400}),
+                          12000);
+  motion.start(sim.context());
+  double duration = trajectory->getDuration().convert(second);
+  TrackingResult result{0, 0};
+  while (!motion.getState()->settled && sim.time < duration + 2) {
+    sim.step(motion.step(sim.context()));
+    TrajectoryPoint reference = trajectory->sample(sim.time * second);
+    double error = std::hypot(reference.pose.x.convert(meter) - sim.x,
+                              reference.pose.y.convert(meter) - sim.y);
+    if (sim.time > duration / 2) {
+      result.lateError = std::max(result.lateError, error);
+    }
+  }
+  TrajectoryPoint end = trajectory->sample(trajectory->getDuration());
+  result.finalError = std::hypot(end.pose.x.convert(meter) - sim.x,
+                                 end.pose.y.convert(meter) - sim.y);
+  return result;
+}
+}  // namespace
+
+APOLLO_TEST(tracksFromTheStart) {
+  TrackingResult result = track(RamseteController(), 0, 0);
+  std::printf("  on track: final %.1f mm, late %.1f mm\n",
+              result.finalError * 1000, result.lateError * 1000);
+  CHECK(result.finalError < 0.01);
+  CHECK(result.lateError < 0.025);
+}
+
+APOLLO_TEST(correctsCrossTrackError) {
+  // Start 10 cm to the side and 15 degrees off.
+  TrackingResult corrected =
+      track(RamseteController(), 0.1, 15 * M_PI / 180);
+  TrackingResult uncorrected =
+      track(RamseteController(1e-9, 0.7), 0.1, 15 * M_PI / 180);
+  std::printf(
+      "  offset start: final %.1f mm, late %.1f mm, without feedback %.1f "
+      "mm\n",
+      corrected.finalError * 1000, corrected.lateError * 1000,
+      uncorrected.finalError * 1000);
+  CHECK(corrected.finalError < 0.015);
+  CHECK(corrected.lateError < 0.05);
+  CHECK(corrected.finalError * 2 < uncorrected.finalError);
+}
+
+APOLLO_TEST(stepCost) {
+  std::shared_ptr<const Trajectory> trajectory = makeTrajectory();
+  RamseteController controller;
+  TrajectoryPoint reference = trajectory->sample(1 * second);
+  Pose pose = reference.pose;
+  double sum = 0;
+  double nanoseconds = test::nanosecondsPerCall(
+      [&] {
+        pose.x += 1e-6 * meter;
+        WheelVelocities wheels =
+            controller.step(pose, reference, constraints.trackWidth);
+        sum += wheels.left.getValue();
+      },
+      1000000);
+  test::doNotOptimize(sum);
+  std::printf("  RAMSETE step: %.1f ns\n", nanoseconds);
+  CHECK(nanoseconds < 2000);
+}
@@ -0,0 +1,37 @@
+#include "simDevices.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace apollo::sim {
+namespace {
+std::array<MotorState, portCount> motors;
+std::array<ImuState, portCount> imus;
+std::array<GpsState, portCount> gpses;
+std::array<std::int32_t, portCount> rotations;
+std::array<std::int32_t, portCount> adiEncoders;
+std::array<std::int32_t, 4> controllerAxes;
+std::atomic<std::uint64_t> time{0};
+}  // namespace
+
+MotorState& motor(int port) { return motors.at(port); }
+ImuState& imu(int port) { return imus.at(port); }
+GpsState& gps(int port) { return gpses.at(port); }
+std::int32_t& rotation(int port) { return rotations.at(port); }
+std::int32_t& adiEncoder(int adiPort) { return adiEncoders.at(adiPort); }
+std::int32_t& controllerAxis(int axis) { return controllerAxes.at(axis); }
+
+void setTime(std::uint64_t micros) { time = micros; }
+void advanceTime(std::uint64_t micros) { time += micros; }
+std::uint64_t now() { return time; }
+
+void reset() {
+  motors.fill(MotorState());
+  imus.fill(ImuState());
+  gpses.fill(GpsState());
+  rotations.fill(0);
+  adiEncoders.fill(0);
+  controllerAxes.fill(0);
+  time = 0;
+}
+}  // namespace apollo::sim
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+// State behind the host pros stubs. Tests set sensor readings here and
+// read back what Apollo commanded. Ports index straight into the tables.
+namespace apollo::sim {
+struct MotorState {
+  // Readings as the motor reports them, already in its reversed frame.
+  double position = 0;
+  double velocity = 0;
+  std::int32_t currentDraw = 0;
+  // Encoder counts per output revolution, 900 for a green cartridge.
+  double countsPerRevolution = 900;
+  std::uint32_t rawTimestamp = 0;
+  // An unplugged motor reports PROS_ERR / PROS_ERR_F.
+  bool unplugged = false;
+  bool reversed = false;
+  std::int32_t voltage = 0;
+  std::int32_t velocityTarget = 0;
+  std::int32_t currentLimit = 2500;
+  int currentLimitWrites = 0;
+  int currentDrawReads = 0;
+};
+struct ImuState {
+  double heading = 0;
+  double rotation = 0;
+  double gyroZ = 0;
+  double accelX = 0;
+  double accelY = 0;
+  double accelZ = 0;
+};
+struct GpsState {
+  double x = 0;
+  double y = 0;
+  double heading = 0;
+  double error = 0;
+  int statusReads = 0;
+};
+
+constexpr int portCount = 32;
+MotorState& motor(int port);
+ImuState& imu(int port);
+GpsState& gps(int port);
+// Rotation sensor position in centidegrees.
+std::int32_t& rotation(int port);
+// ADI encoder count, by the top ADI port.
+std::int32_t& adiEncoder(int adiPort);
+// Master controller analog axis, -127 to 127, by controller_analog_e_t.
+std::int32_t& controllerAxis(int axis);
+
+// pros::millis and pros::micros read this clock. It only moves when a
+// test moves it.
+void setTime(std::uint64_t micros);
+void advanceTime(std::uint64_t micros);
+std::uint64_t now();
+
+void reset();
+}  // namespace apollo::sim
@@ -0,0 +1,121 @@
+#include "apollo/chassis/hDrive.hpp"
+#include "apollo/chassis/tankDrive.hpp"
+#include "apollo/chassis/timestampAligner.hpp"
+#include "harness.hpp"
+#include "simDevices.hpp"
+
+using namespace apollo;
+
+namespace {
+class TopSpeedTank : public Tank {
+ public:
+  using Tank::Tank;
+  using Tank::getTopSpeed;
+};
+
+// Two motors a side, each read at its own time, with the left wheels
+// turning 10 degrees per ms and the right 20.
+SensorFrame staggeredFrame(double leftTime, double rightTime) {
+  SensorFrame frame;
+  frame.leftMotorCount = 2;
+  frame.rightMotorCount = 2;
+  for (std::size_t i = 0; i < 2; i++) {
+    double left = leftTime + 2 * i;
+    double right = rightTime + 2 * i;
+    frame.leftMotors[i].rawTimestamp = left * millisecond;
+    frame.leftMotors[i].rawPosition = 10 * left * degree;
+    frame.rightMotors[i].rawTimestamp = right * millisecond;
+    frame.rightMotors[i].rawPosition = 20 * right * degree;
+  }
+  return frame;
+}
+}  // namespace
+
+APOLLO_TEST(rawPositionFollowsTheReversedFlag) {
+  sim::reset();
+  Tank chassis({1, -2}, {3, -4}, 10, 200, 1.0, 4.0);
+  // The first tick applies the initial sensor reset.
+  chassis.update();
+  for (int port : {1, 2, 3, 4}) {
+    sim::motor(port).position = 360;
+    sim::motor(port).rawTimestamp = 7;
+  }
+  chassis.update();
+  const SensorFrame& frame = chassis.getSensorFrame();
+  for (std::size_t i = 0; i < 2; i++) {
+    CHECK_NEAR(frame.leftMotors[i].rawPosition.convert(degree), 360, 1e-9);
+    CHECK_NEAR(frame.rightMotors[i].rawPosition.convert(degree), 360, 1e-9);
+    CHECK_NEAR(frame.leftMotors[i].rawTimestamp.convert(millisecond), 7,
+               1e-9);
+  }
+}
+
+APOLLO_TEST(unpluggedMotorHoldsItsLastSample) {
+  sim::reset();
+  Tank chassis({1, 2}, {3, 4}, 10, 200, 1.0, 4.0);
+  chassis.update();
+  sim::motor(2).position = 90;
+  sim::motor(2).velocity = 50;
+  sim::motor(2).currentDraw = 1200;
+  chassis.update();
+  sim::motor(2).unplugged = true;
+  chassis.update();
+  const MotorSample& sample = chassis.getSensorFrame().leftMotors[1];
+  CHECK_NEAR(sample.position.convert(degree), 90, 1e-9);
+  CHECK_NEAR(sample.rawPosition.convert(degree), 90, 1e-9);
+  CHECK_NEAR(sample.velocity.convert(rpm), 50, 1e-9);
+  CHECK_NEAR(sample.current, 1200, 1e-9);
+}
+
+APOLLO_TEST(hDriveStrafeWheelsAreTheCenterTracker) {
+  sim::reset();
+  HDrive chassis({1, 2}, {3, 4}, {5}, 10, 200, 1.0, 4.0, 1.0, 4.0,
+                 30 * centimeter);
+  CHECK_NEAR(chassis.getKinematics().getTrackWidth().convert(centimeter), 30,
+             1e-9);
+  chassis.update();
+  for (int port : {1, 2, 3, 4, 5}) {
+    sim::motor(port).position = 360;
+  }
+  chassis.update();
+  // Drive tracker ticks are motor degrees, so one strafe wheel turn at the
+  // drive gearing and wheel size counts 360. Strafing right is negative.
+  const SensorFrame& frame = chassis.getSensorFrame();
+  CHECK_NEAR(frame.centerTrackerCount, -360, 1e-9);
+  // A sensor reset tares the strafe motors along with the sides.
+  chassis.resetSensors();
+  chassis.update();
+  CHECK_NEAR(frame.centerTrackerCount, 0, 1e-9);
+}
+
+APOLLO_TEST(rotationTrackerTankKnowsItsWheels) {
+  sim::reset();
+  TopSpeedTank motorTracked({1, 2}, {3, 4}, 10, 200, 1.0, 4.0);
+  TopSpeedTank rotationTracked({1, 2}, {3, 4}, 10, 200, 1.0, 4.0, 5, 6);
+  TopSpeedTank threeTrackers({1, 2}, {3, 4}, 10, 200, 1.0, 4.0, 5, 6, 7);
+  CHECK(rotationTracked.getTopSpeed() > 0 * mps);
+  CHECK_NEAR(rotationTracked.getTopSpeed().convert(mps),
+             motorTracked.getTopSpeed().convert(mps), 1e-12);
+  CHECK_NEAR(threeTrackers.getTopSpeed().convert(mps),
+             motorTracked.getTopSpeed().convert(mps), 1e-12);
+}
+
+APOLLO_TEST(alignerInterpolatesToTheOldestReading) {
+  TimestampAligner aligner;
+  SensorFrame previous = staggeredFrame(10, 11);
+  previous.timestamp = 15 * millisecond;
+  aligner.align(previous);
+  SensorFrame current = staggeredFrame(20, 21);
+  current.timestamp = 25 * millisecond;
+  current.rotation = 90 * degree;
+  current.headingRate = 100 * degree / second;
+  TimestampAligner::AlignedSides sides = aligner.align(current);
+  // Readings at 20/22 ms left and 21/23 ms right all land on 20 ms.
+  CHECK_NEAR(sides.timestamp.convert(millisecond), 20, 1e-9);
+  CHECK_NEAR(sides.left.convert(degree), 200, 1e-9);
+  CHECK_NEAR(sides.right.convert(degree), 400, 1e-9);
+  // The IMU read at 25 ms is carried back 5 ms along its rate.
+  CHECK_NEAR(TimestampAligner::alignRotation(current, sides.timestamp)
+                 .convert(degree),
+             89.5, 1e-9);
+}
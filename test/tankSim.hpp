@@ -0,0 +1,71 @@
+#pragma once
+#include <cmath>
+
+#include "apollo/chassis/motion.hpp"
+
+namespace apollo::test {
+// Kinematic differential drive whose side speeds follow the commanded
+// voltage with a first order lag. Enough to close the loop around a motion
+// without any devices.
+class TankSim {
+ public:
+  double trackWidth = 0.3;      // m
+  double topSpeed = 1.5;        // m/s at 12 V
+  double timeConstant = 0.05;   // s
+  double tick = 0.01;           // s
+  double frictionVoltage = 0;   // mV lost to static friction
+
+  void step(const DriveOutput& output) {
+    double alpha = tick / (timeConstant + tick);
+    leftSpeed += alpha * (targetSpeed(output.left) - leftSpeed);
+    rightSpeed += alpha * (targetSpeed(output.right) - rightSpeed);
+    double forward = (leftSpeed + rightSpeed) / 2 * tick;
+    double turn = (rightSpeed - leftSpeed) / trackWidth * tick;
+    x += forward * std::cos(theta + turn / 2);
+    y += forward * std::sin(theta + turn / 2);
+    theta += turn;
+    leftDistance += leftSpeed * tick;
+    rightDistance += rightSpeed * tick;
+    time += tick;
+  }
+  MotionContext context() const {
+    return {frame,
+            {x * meter, y * meter, theta * radian, time * second},
+            leftDistance * meter,
+            rightDistance * meter,
+            leftSpeed * mps,
+            rightSpeed * mps,
+            time * second};
+  }
+  // Starts the motion and steps it until it settles or the time runs out.
+  // Returns the number of ticks it ran.
+  int run(Motion& motion, double maxTime = 10) {
+    motion.start(context());
+    int ticks = 0;
+    while (!motion.getState()->settled && time < maxTime) {
+      DriveOutput output = motion.step(context());
+      if (motion.getState()->settled) {
+        break;
+      }
+      step(output);
+      ticks++;
+    }
+    return ticks;
+  }
+
+  double targetSpeed(double voltage) const {
+    double driving = std::fmax(std::fabs(voltage) - frictionVoltage, 0);
+    return std::copysign(driving, voltage) / 12000 * topSpeed;
+  }
+
+  SensorFrame frame;
+  double x = 0;
+  double y = 0;
+  double theta = 0;
+  double leftSpeed = 0;
+  double rightSpeed = 0;
+  double leftDistance = 0;
+  double rightDistance = 0;
+  double time = 0;
+};
+}  // namespace apollo::test
@@ -0,0 +1,140 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "apollo/trajectory/trajectoryFile.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr TrajectoryConstraints constraints{1.5 * mps, 2 * mps2,
+                                            30 * centimeter};
+
+Trajectory makeTrajectory() {
+  return TrajectoryGenerator(constraints)
+      .generate(SplinePath({{0 * meter, 0 * meter, 0 * degree},
+                            {1 * meter, 0.6 * meter, 60 * degree},
+                            {0.5 * meter, 1.5 * meter, 150 * degree}}));
+}
+std::string tempPath(const char* name) {
+  return std::string("/tmp/apollo_") + name + ".traj";
+}
+// float32 storage keeps about seven significant digits.
+void checkSame(const TrajectoryPoint& read, const TrajectoryPoint& expected) {
+  CHECK_NEAR(read.pose.x.convert(meter), expected.pose.x.convert(meter),
+             1e-5);
+  CHECK_NEAR(read.pose.y.convert(meter), expected.pose.y.convert(meter),
+             1e-5);
+  CHECK_NEAR(read.pose.theta.convert(radian),
+             expected.pose.theta.convert(radian), 1e-5);
+  CHECK_NEAR(read.distance.convert(meter), expected.distance.convert(meter),
+             1e-5);
+  CHECK_NEAR(read.velocity.convert(mps), expected.velocity.convert(mps),
+             1e-5);
+  CHECK_NEAR(read.leftVelocity.convert(mps),
+             expected.leftVelocity.convert(mps), 1e-4);
+  CHECK_NEAR(read.rightVelocity.convert(mps),
+             expected.rightVelocity.convert(mps), 1e-4);
+}
+// Overwrites a little endian header field of a written file.
+void patchHeader(const std::string& path, long offset, std::uint32_t value) {
+  std::FILE* file = std::fopen(path.c_str(), "r+b");
+  std::uint8_t bytes[4];
+  for (int i = 0; i < 4; i++) {
+    bytes[i] = (value >> (8 * i)) & 0xFF;
+  }
+  std::fseek(file, offset, SEEK_SET);
+  std::fwrite(bytes, 1, 4, file);
+  std::fclose(file);
+}
+}  // namespace
+
+APOLLO_TEST(roundTripsThroughAFile) {
+  Trajectory trajectory = makeTrajectory();
+  std::string path = tempPath("roundTrip");
+  CHECK(TrajectoryWriter(32).write(trajectory, constraints.trackWidth,
+                                   path.c_str()));
+  TrajectoryReader reader;
+  CHECK(reader.open(path.c_str()));
+  CHECK(reader.size() == trajectory.size());
+  CHECK_NEAR(reader.getDuration().convert(second),
+             trajectory.getDuration().convert(second), 1e-5);
+  CHECK_NEAR(reader.getLength().convert(meter),
+             trajectory.getLength().convert(meter), 1e-5);
+  // Seeks backwards and forwards, including across chunk boundaries.
+  double duration = trajectory.getDuration().convert(second);
+  for (double t : {0.0, 1.0, 0.25, duration, duration / 2, 0.0}) {
+    checkSame(reader.sample(t * second), trajectory.sample(t * second));
+  }
+  reader.close();
+  std::remove(path.c_str());
+}
+
+APOLLO_TEST(playingForwardOnlySwapsBuffers) {
+  Trajectory trajectory = makeTrajectory();
+  std::string path = tempPath("prefetch");
+  CHECK(TrajectoryWriter(16).write(trajectory, constraints.trackWidth,
+                                   path.c_str()));
+  TrajectoryReader reader;
+  CHECK(reader.open(path.c_str()));
+  double duration = trajectory.getDuration().convert(second);
+  for (double t = 0; t <= duration; t += 0.01) {
+    checkSame(reader.sample(t * second), trajectory.sample(t * second));
+    // A control tick's worth of time for the read ahead.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // Only the chunk read by open().
+  CHECK(reader.getBlockingReads() == 1);
+  reader.close();
+  std::remove(path.c_str());
+}
+
+APOLLO_TEST(rejectsBadFiles) {
+  TrajectoryReader reader;
+  CHECK(!reader.open("/tmp/apollo_missing.traj"));
+  std::string path = tempPath("truncated");
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  std::fputs("APTR", file);
+  std::fclose(file);
+  CHECK(!reader.open(path.c_str()));
+  CHECK(!reader.isOpen());
+  std::remove(path.c_str());
+}
+
+APOLLO_TEST(rejectsHeadersThatDisagreeWithTheFile) {
+  Trajectory trajectory = makeTrajectory();
+  std::string path = tempPath("corrupt");
+  TrajectoryReader reader;
+  struct Corruption {
+    long offset;
+    std::uint32_t value;
+  };
+  // Point counts and chunk sizes past what the file holds, a chunk size
+  // over the limit, and one whose chunk byte size wraps 32 bits to 32.
+  for (Corruption corruption :
+       {Corruption{8, std::uint32_t(trajectory.size() + 64)},
+        Corruption{8, 0xFFFFFFFF}, Corruption{12, 64},
+        Corruption{12, trajectoryFile::maxChunkSize + 1},
+        Corruption{12, 0x08000001}}) {
+    CHECK(TrajectoryWriter(32).write(trajectory, 30 * centimeter,
+                                     path.c_str()));
+    CHECK(reader.open(path.c_str()));
+    reader.close();
+    patchHeader(path, corruption.offset, corruption.value);
+    CHECK(!reader.open(path.c_str()));
+    CHECK(!reader.isOpen());
+  }
+  // A file cut short inside its last chunk.
+  CHECK(TrajectoryWriter(32).write(trajectory, 30 * centimeter, path.c_str()));
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  std::fseek(file, 0, SEEK_END);
+  long size = std::ftell(file);
+  std::fclose(file);
+  CHECK(truncate(path.c_str(), size - 4) == 0);
+  CHECK(!reader.open(path.c_str()));
+  std::remove(path.c_str());
+}
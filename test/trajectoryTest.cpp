@@ -0,0 +1,93 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "apollo/trajectory/spline.hpp"
+#include "apollo/trajectory/trajectory.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr TrajectoryConstraints constraints{1.5 * mps, 2 * mps2,
+                                            30 * centimeter};
+
+SplinePath sCurvePath() {
+  return SplinePath({{0 * meter, 0 * meter, 0 * degree},
+                     {1 * meter, 0.5 * meter, 45 * degree},
+                     {2 * meter, 1 * meter, 0 * degree}});
+}
+}  // namespace
+
+APOLLO_TEST(splinePassesThroughItsPoints) {
+  QuinticSpline spline({0 * meter, 0 * meter, 0 * degree},
+                       {1 * meter, 1 * meter, 90 * degree});
+  double x, y, dx, dy;
+  spline.position(0, x, y);
+  CHECK_NEAR(x, 0, 1e-12);
+  CHECK_NEAR(y, 0, 1e-12);
+  spline.position(1, x, y);
+  CHECK_NEAR(x, 1, 1e-12);
+  CHECK_NEAR(y, 1, 1e-12);
+  spline.derivative(0, dx, dy);
+  CHECK_NEAR(std::atan2(dy, dx), 0, 1e-12);
+  spline.derivative(1, dx, dy);
+  CHECK_NEAR(std::atan2(dy, dx), M_PI / 2, 1e-12);
+  // Zero second derivative at the ends, so no curvature jump at joins.
+  CHECK_NEAR(spline.curvature(0), 0, 1e-12);
+  CHECK_NEAR(spline.curvature(1), 0, 1e-12);
+  CHECK(spline.curvature(0.5) > 0);
+}
+
+APOLLO_TEST(trajectoryRespectsWheelAndAccelerationLimits) {
+  Trajectory trajectory = TrajectoryGenerator(constraints).generate(
+      sCurvePath());
+  CHECK(trajectory.size() > 200);
+  double maxWheel = constraints.maxVelocity.convert(mps);
+  for (std::size_t i = 0; i < trajectory.size(); i++) {
+    const TrajectoryPoint& point = trajectory[i];
+    CHECK(std::fabs(point.leftVelocity.convert(mps)) <= maxWheel + 1e-9);
+    CHECK(std::fabs(point.rightVelocity.convert(mps)) <= maxWheel + 1e-9);
+    CHECK(std::fabs(point.acceleration.convert(mps2)) <= 2 + 1e-6);
+    CHECK_NEAR(
+        (point.leftVelocity + point.rightVelocity).convert(mps) / 2,
+        point.velocity.convert(mps), 1e-9);
+  }
+  const TrajectoryPoint& first = trajectory[0];
+  const TrajectoryPoint& last = trajectory[trajectory.size() - 1];
+  CHECK_NEAR(first.velocity.convert(mps), 0, 1e-9);
+  CHECK_NEAR(last.velocity.convert(mps), 0, 1e-9);
+  CHECK_NEAR(last.pose.x.convert(meter), 2, 1e-3);
+  CHECK_NEAR(last.pose.y.convert(meter), 1, 1e-3);
+  CHECK_NEAR(last.pose.theta.convert(degree), 0, 0.5);
+}
+
+APOLLO_TEST(straightTrajectoryIsTimeOptimal) {
+  Trajectory trajectory = TrajectoryGenerator(constraints).generate(
+      SplinePath({{0 * meter, 0 * meter, 0 * degree},
+                  {3 * meter, 0 * meter, 0 * degree}}));
+  // 0.75 s up to 1.5 m/s, 0.75 s down, and 1.875 m at speed in between.
+  CHECK_NEAR(trajectory.getDuration().convert(second), 2.75, 0.02);
+  CHECK_NEAR(trajectory.getLength().convert(meter), 3, 1e-3);
+  TrajectoryPoint middle = trajectory.sample(1.375 * second);
+  CHECK_NEAR(middle.velocity.convert(mps), 1.5, 1e-6);
+  CHECK_NEAR(middle.pose.x.convert(meter), 1.5, 0.01);
+}
+
+APOLLO_TEST(generationTime) {
+  std::vector<SplinePoint> points;
+  for (int i = 0; i <= 10; i++) {
+    points.push_back({i * 0.6 * meter, (i % 2) * 0.6 * meter,
+                      (i % 2 ? -45 : 45) * degree});
+  }
+  SplinePath path(points);
+  TrajectoryGenerator generator(constraints);
+  auto start = std::chrono::steady_clock::now();
+  Trajectory trajectory = generator.generate(path);
+  auto end = std::chrono::steady_clock::now();
+  double milliseconds =
+      std::chrono::duration<double, std::milli>(end - start).count();
+  std::printf("  %zu points over %.2f m in %.2f ms\n", trajectory.size(),
+              trajectory.getLength().convert(meter), milliseconds);
+  CHECK(!trajectory.empty());
+}
@@ -0,0 +1,91 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "apollo/chassis/pose.hpp"
+#include "apollo/util/tripleBuffer.hpp"
+#include "harness.hpp"
+
+using namespace apollo;
+
+namespace {
+// Every field is derived from the same counter, so a torn read shows up as
+// fields that disagree.
+struct Snapshot {
+  std::uint64_t counter;
+  double values[7];
+};
+Snapshot makeSnapshot(std::uint64_t counter) {
+  Snapshot snapshot{counter, {}};
+  for (int i = 0; i < 7; i++) {
+    snapshot.values[i] = static_cast<double>(counter) * (i + 1);
+  }
+  return snapshot;
+}
+bool isConsistent(const Snapshot& snapshot) {
+  for (int i = 0; i < 7; i++) {
+    if (snapshot.values[i] != static_cast<double>(snapshot.counter) * (i + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+APOLLO_TEST(readsTheLatestValue) {
+  PoseBuffer buffer;
+  CHECK(buffer.getVersion() == 0);
+  buffer.publish({1 * inch, 2 * inch, 90 * degree, 10 * millisecond});
+  buffer.publish({3 * inch, 4 * inch, 45 * degree, 20 * millisecond});
+  Pose pose = buffer.read();
+  CHECK_NEAR(pose.x.convert(inch), 3, 1e-12);
+  CHECK_NEAR(pose.y.convert(inch), 4, 1e-12);
+  CHECK_NEAR(pose.theta.convert(degree), 45, 1e-12);
+  CHECK(buffer.getVersion() == 2);
+}
+
+APOLLO_TEST(readersNeverSeeTornOrStaleSnapshots) {
+  constexpr std::uint64_t publishes = 2000000;
+  constexpr int readerCount = 3;
+  util::TripleBuffer<Snapshot> buffer(makeSnapshot(0));
+  std::atomic<bool> done{false};
+  std::atomic<int> tornReads{0};
+  std::atomic<int> backwardReads{0};
+  std::atomic<std::uint64_t> totalReads{0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < readerCount; i++) {
+    readers.emplace_back([&] {
+      std::uint64_t lastCounter = 0;
+      std::uint64_t reads = 0;
+      while (!done) {
+        Snapshot snapshot = buffer.read();
+        if (!isConsistent(snapshot)) {
+          tornReads++;
+        }
+        if (snapshot.counter < lastCounter) {
+          backwardReads++;
+        }
+        lastCounter = snapshot.counter;
+        reads++;
+      }
+      totalReads += reads;
+    });
+  }
+  std::thread writer([&] {
+    for (std::uint64_t counter = 1; counter <= publishes; counter++) {
+      buffer.publish(makeSnapshot(counter));
+    }
+    done = true;
+  });
+  writer.join();
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+
+  CHECK(tornReads == 0);
+  CHECK(backwardReads == 0);
+  CHECK(totalReads > 0);
+  CHECK(buffer.read().counter == publishes);
+  CHECK(buffer.getVersion() == publishes);
+}
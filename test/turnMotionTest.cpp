@@ -0,0 +1,43 @@
+#include <cmath>
+
+#include "apollo/chassis/motions.hpp"
+#include "harness.hpp"
+#include "tankSim.hpp"
+
+using namespace apollo;
+
+namespace {
+constexpr PIDGains turnGains{12000, 0, 600};
+constexpr PIDGains holdGains{40000, 0, 0};
+
+double degreesOf(double radians) { return radians * 180 / M_PI; }
+}  // namespace
+
+APOLLO_TEST(turnTakesTheShortestWay) {
+  struct Case {
+    double start;
+    double target;
+    double turned;
+  };
+  // Odometry heading is continuous, so starts past a full turn are normal.
+  for (Case c : {Case{350, 10, 20}, Case{10, 350, -20}, Case{0, 270, -90},
+                 Case{720, 90, 90}, Case{-540, 10, -170}}) {
+    test::TankSim sim;
+    sim.theta = c.start * M_PI / 180;
+    TurnMotion motion(c.target * degree, 12000, turnGains);
+    sim.run(motion);
+    CHECK(motion.getState()->reason == exit_small_error);
+    CHECK_NEAR(degreesOf(sim.theta) - c.start, c.turned, 1.5);
+  }
+}
+
+APOLLO_TEST(swingTakesTheShortestWay) {
+  test::TankSim sim;
+  sim.theta = 350 * M_PI / 180;
+  SwingMotion motion(RIGHT, 10 * degree, 12000, turnGains, holdGains);
+  sim.run(motion);
+  CHECK(motion.getState()->reason == exit_small_error);
+  CHECK_NEAR(degreesOf(sim.theta), 370, 1.5);
+  // The left side holds while the right drives round.
+  CHECK_NEAR(sim.leftDistance, 0, 0.01);
+}